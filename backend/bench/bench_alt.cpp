@@ -0,0 +1,85 @@
+// A* heuristics compared: haversine (the original aStarPath) vs ALT with
+// different landmark counts and selection strategies. Reports nodes
+// settled and latency per query, and checks every path cost against Dijkstra.
+//
+//   make bench && ./bench/bin/bench_alt [rows cols queries]
+//   BENCH_GRAPH=road:1000000 (or ny.gr, graph.snap) ./bench/bin/bench_alt 0 0 [queries]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/landmarks.h"
+#include "../include/json.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+static double pathCost(const Graph& g,const vector<int>& path) {
+    double c=0;
+    for (size_t i=0; i+1<path.size(); ++i) c+=g.getEdgeWeight(path[i],path[i+1]);
+    return c;
+}
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 150;
+    int cols=argc>2 ? atoi(argv[2]) : 150;
+    int queries=argc>3 ? atoi(argv[3]) : 100;
+
+    Graph g;
+    buildBenchGraph(g,rows,cols,42);
+    int n=g.csr().numNodes;
+
+    mt19937 rng(5);
+    vector<pair<int,int>> pairs(queries);
+    vector<double> ref(queries);
+    for (int q=0; q<queries; ++q) {
+        pairs[q]={(int)(rng()%n),(int)(rng()%n)};
+        ref[q]=dijkstra(g,pairs[q].first)[pairs[q].second];
+    }
+
+    json out;
+    out["graph"]={{"nodes",n},{"rows",rows},{"cols",cols}};
+    out["results"]=json::array();
+    int errors=0;
+
+    auto run=[&](const string& name,const LandmarkIndex* lm,double buildMs) {
+        vector<double> samples;
+        long long settledTotal=0;
+        for (int q=0; q<queries; ++q) {
+            int settled=0;
+            long long t0=nowNs();
+            vector<int> path=lm ? aStarPath(g,pairs[q].first,pairs[q].second,*lm,&settled)
+                                : aStarPath(g,pairs[q].first,pairs[q].second,&settled);
+            samples.push_back((double)(nowNs()-t0));
+            settledTotal+=settled;
+            if (fabs(pathCost(g,path)-ref[q])>1e-9) ++errors;
+        }
+        double total=0;
+        for (double s:samples) total+=s;
+        json r;
+        r["name"]=name;
+        r["build_ms"]=buildMs;
+        r["settled_per_query"]=(double)settledTotal/queries;
+        r["ns_per_op"]=total/queries;
+        r["p50_ns"]=percentile(samples,50);
+        r["p99_ns"]=percentile(samples,99);
+        out["results"].push_back(r);
+    };
+
+    run("astar_haversine",nullptr,0);
+    for (int k:{4,8,16}) {
+        for (auto sel:{LandmarkSelection::Farthest,LandmarkSelection::Avoid}) {
+            LandmarkIndex lm;
+            long long t0=nowNs();
+            lm.build(g,k,sel);
+            double ms=(nowNs()-t0)/1e6;
+            run(string("alt_")+(sel==LandmarkSelection::Avoid ? "avoid_" : "farthest_")+to_string(k),&lm,ms);
+        }
+    }
+    out["suboptimal_paths"]=errors;
+    cout<<out.dump(2)<<endl;
+    return errors==0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+// Point-to-point engines for one fixed-order leg: full dijkstraWithPath
+// (settles the whole graph) vs bidirectional Dijkstra, unidirectional ALT
+// A* and bidirectional ALT A*. Reports settled nodes and latency per
+// query, and checks every returned path against the Dijkstra distance.
+//
+//   make bench && ./bench/bin/bench_bidirectional [rows cols queries]
+//   BENCH_GRAPH=road:1000000 (or ny.gr, graph.snap) ./bench/bin/bench_bidirectional 0 0 [queries]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/landmarks.h"
+#include "../include/json.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 150;
+    int cols=argc>2 ? atoi(argv[2]) : 150;
+    int queries=argc>3 ? atoi(argv[3]) : 100;
+
+    Graph g;
+    buildBenchGraph(g,rows,cols,42);
+    int n=g.csr().numNodes;
+    LandmarkIndex lm;
+    lm.build(g,8);
+
+    mt19937 rng(9);
+    vector<pair<int,int>> pairs(queries);
+    vector<double> ref(queries);
+    for (int q=0; q<queries; ++q) {
+        pairs[q]={(int)(rng()%n),(int)(rng()%n)};
+        ref[q]=dijkstra(g,pairs[q].first)[pairs[q].second];
+    }
+
+    json out;
+    out["graph"]={{"nodes",n},{"rows",rows},{"cols",cols}};
+    out["results"]=json::array();
+    int errors=0;
+
+    // op returns the path and writes the settled count
+    auto run=[&](const string& name,const function<vector<int>(int,int,int*)>& op) {
+        vector<double> samples;
+        long long settledTotal=0;
+        for (int q=0; q<queries; ++q) {
+            int settled=0;
+            long long t0=nowNs();
+            vector<int> path=op(pairs[q].first,pairs[q].second,&settled);
+            samples.push_back((double)(nowNs()-t0));
+            settledTotal+=settled;
+            double c=0;
+            for (size_t i=0; i+1<path.size(); ++i) c+=g.getEdgeWeight(path[i],path[i+1]);
+            if (fabs(c-ref[q])>1e-9) ++errors;
+        }
+        double total=0;
+        for (double s:samples) total+=s;
+        json r;
+        r["name"]=name;
+        r["settled_per_query"]=(double)settledTotal/queries;
+        r["ns_per_op"]=total/queries;
+        r["p50_ns"]=percentile(samples,50);
+        r["p99_ns"]=percentile(samples,99);
+        out["results"].push_back(r);
+    };
+
+    run("dijkstraWithPath",[&](int s,int t,int* settled) {
+        auto tree=dijkstraWithPath(g,s);
+        *settled=n;
+        return reconstructPath(tree.second,s,t);
+    });
+    run("bidirectionalDijkstra",[&](int s,int t,int* settled) { return bidirectionalDijkstra(g,s,t,settled).second; });
+    run("aStarPath_alt8",[&](int s,int t,int* settled) { return aStarPath(g,s,t,lm,settled); });
+    run("bidirectionalAStar_alt8",[&](int s,int t,int* settled) { return bidirectionalAStar(g,s,t,lm,settled).second; });
+
+    out["suboptimal_paths"]=errors;
+    cout<<out.dump(2)<<endl;
+    return errors==0 ? 0 : 1;
+}
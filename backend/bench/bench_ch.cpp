@@ -0,0 +1,100 @@
+// Contraction Hierarchies vs plain Dijkstra on a synthetic grid.
+// Reports preprocessing cost, per-query latency for dijkstra(),
+// dijkstraWithPath()+reconstructPath() and the CH query/path unpacking,
+// and checks that every CH answer matches Dijkstra.
+//
+//   make bench && ./bench/bin/bench_ch [rows cols queries]
+//   BENCH_GRAPH=road:1000000 (or ny.gr, graph.snap) ./bench/bin/bench_ch 0 0 [queries]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/contraction_hierarchy.h"
+#include "../include/json.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+static json summary(const string& name,vector<double>& samples) {
+    double total=0;
+    for (double s:samples) total+=s;
+    json r;
+    r["name"]=name;
+    r["queries"]=samples.size();
+    r["ns_per_op"]=samples.empty() ? 0 : total/samples.size();
+    r["p50_ns"]=percentile(samples,50);
+    r["p99_ns"]=percentile(samples,99);
+    return r;
+}
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 150;
+    int cols=argc>2 ? atoi(argv[2]) : 150;
+    int queries=argc>3 ? atoi(argv[3]) : 200;
+
+    Graph g;
+    buildBenchGraph(g,rows,cols,42);
+    int n=g.csr().numNodes;
+
+    long long t0=nowNs();
+    ContractionHierarchy ch;
+    ch.build(g);
+    long long buildNs=nowNs()-t0;
+
+    mt19937 rng(11);
+    vector<pair<int,int>> pairs(queries);
+    for (auto& p:pairs) p={(int)(rng()%n),(int)(rng()%n)};
+
+    vector<double> dj,djPath,chDist,chPath;
+    int mismatches=0;
+    for (auto& p:pairs) {
+        long long a=nowNs();
+        double ref=dijkstra(g,p.first)[p.second];
+        dj.push_back((double)(nowNs()-a));
+
+        a=nowNs();
+        auto tree=dijkstraWithPath(g,p.first);
+        vector<int> refPath=reconstructPath(tree.second,p.first,p.second);
+        djPath.push_back((double)(nowNs()-a));
+
+        a=nowNs();
+        double d=ch.distance(p.first,p.second);
+        chDist.push_back((double)(nowNs()-a));
+
+        a=nowNs();
+        auto sp=ch.shortestPath(p.first,p.second);
+        chPath.push_back((double)(nowNs()-a));
+
+        // the unpacked path must be a real road path of the same length
+        double walked=0;
+        for (size_t i=0; i+1<sp.second.size(); ++i) walked+=g.getEdgeWeight(sp.second[i],sp.second[i+1]);
+        if (fabs(ref-d)>1e-9 || fabs(ref-walked)>1e-9 || refPath.size()<2 || sp.second.front()!=p.first)
+            if (p.first!=p.second) ++mismatches;
+    }
+
+    // bucket many-to-many table against the Dijkstra-based one
+    vector<int> locs;
+    for (int i=0; i<25; ++i) locs.push_back((int)(rng()%n));
+    long long m0=nowNs();
+    DistanceMatrix ref=buildDistanceMatrix(g,locs);
+    long long m1=nowNs();
+    DistanceMatrix chm=ch.distanceMatrix(locs);
+    long long m2=nowNs();
+    for (size_t i=0; i<locs.size(); ++i)
+        for (size_t j=0; j<locs.size(); ++j)
+            if (fabs(ref[i][j]-chm[i][j])>1e-9) ++mismatches;
+
+    json out;
+    out["matrix_25x25_ms"]={{"buildDistanceMatrix",(m1-m0)/1e6},{"ch_distanceMatrix",(m2-m1)/1e6}};
+    out["graph"]={{"nodes",n},{"rows",rows},{"cols",cols}};
+    out["build_ms"]=buildNs/1e6;
+    out["shortcuts"]=ch.numShortcuts();
+    out["mismatches"]=mismatches;
+    out["results"]=json::array({summary("dijkstra",dj),summary("dijkstraWithPath",djPath),
+                                summary("ch_distance",chDist),summary("ch_shortestPath",chPath)});
+    cout<<out.dump(2)<<endl;
+    return mismatches==0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+// CSV ingestion: loadFromCSV on a synthetic rows x cols grid written out as
+// attractions/roads CSVs (1000 x 1000 gives 1M attractions, ~2M roads).
+// Reports wall time, throughput and heap allocations for the whole load.
+//
+//   make bench && ./bench/bin/bench_csv_ingest [rows cols]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/json.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sys/stat.h>
+using json = nlohmann::json;
+using namespace std;
+
+static long long fileBytes(const string& path) {
+    struct stat st;
+    return stat(path.c_str(),&st)==0 ? (long long)st.st_size : 0;
+}
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 1000;
+    int cols=argc>2 ? atoi(argv[2]) : 1000;
+    string attractionsFile="bench_csv_attractions.csv",roadsFile="bench_csv_roads.csv";
+    int roads=0;
+    {
+        Graph g;
+        buildGridGraph(g,rows,cols,42);
+        g.saveCSV(attractionsFile,roadsFile);
+        CSRView c=g.csr();
+        roads=c.offsets[c.numNodes]/2;
+    }
+    long long bytes=fileBytes(attractionsFile)+fileBytes(roadsFile);
+
+    Graph g;
+    long long a0=allocCount(),t0=nowNs();
+    g.loadFromCSV(attractionsFile,roadsFile);
+    long long t1=nowNs(),a1=allocCount();
+    CSRView c=g.csr();
+    double sec=(t1-t0)/1e9;
+
+    json out;
+    out["graph"]={{"nodes",c.numNodes},{"roads",roads},{"rows",rows},{"cols",cols},{"megabytes",bytes/1e6}};
+    out["results"]=json::array();
+    out["results"].push_back({{"name","loadFromCSV"},{"ms",sec*1e3},{"rows_per_sec",(c.numNodes+roads)/sec},
+                              {"mb_per_sec",bytes/1e6/sec},{"allocs",a1-a0},
+                              {"allocs_per_row",(double)(a1-a0)/(c.numNodes+roads)}});
+    out["loaded_all"]=c.numNodes==rows*cols && c.offsets[c.numNodes]==2*roads;
+
+    remove(attractionsFile.c_str());
+    remove(roadsFile.c_str());
+    cout<<out.dump(2)<<"\n";
+    return out["loaded_all"].get<bool>() ? 0 : 1;
+}
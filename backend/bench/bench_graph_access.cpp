@@ -0,0 +1,91 @@
+// Allocation / latency microbenchmark for the Graph accessors used on the
+// search hot path: one "query" relaxes every neighbor of a node and reads
+// each neighbor's Attraction, like a Dijkstra/A* expansion does.
+//
+//   make bench && ./bench/bin/bench_graph_access [rows cols queries]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/search_workspace.h"
+#include "../include/json.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+static json measure(const string& name,int queries,const function<void(int)>& op) {
+    vector<double> samples;
+    samples.reserve(queries);
+    long long a0=allocCount(),b0=allocBytes();
+    for (int q=0; q<queries; ++q) {
+        long long t0=nowNs();
+        op(q);
+        samples.push_back((double)(nowNs()-t0));
+    }
+    long long allocs=allocCount()-a0,bytes=allocBytes()-b0;
+    double total=0;
+    for (double s:samples) total+=s;
+    json r;
+    r["name"]=name;
+    r["queries"]=queries;
+    r["ns_per_op"]=total/queries;
+    r["p50_ns"]=percentile(samples,50);
+    r["p99_ns"]=percentile(samples,99);
+    r["allocs_per_op"]=(double)allocs/queries;
+    r["bytes_per_op"]=(double)bytes/queries;
+    return r;
+}
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 200;
+    int cols=argc>2 ? atoi(argv[2]) : 200;
+    int queries=argc>3 ? atoi(argv[3]) : 200000;
+
+    Graph g;
+    buildGridGraph(g,rows,cols,42);
+    int n=g.csr().numNodes;
+
+    mt19937 rng(7);
+    vector<int> nodes(queries);
+    for (int& x:nodes) x=(int)(rng()%n);
+
+    volatile double sink=0;
+    json out;
+    out["graph"]={{"nodes",n},{"rows",rows},{"cols",cols}};
+    out["results"]=json::array();
+
+    out["results"].push_back(measure("neighbor_scan",queries,[&](int q) {
+        double acc=0;
+        for (Neighbor nb:g.getNeighbors(nodes[q])) {
+            const Attraction& a=g.getAttraction(nb.id);
+            acc+=nb.weight+a.latitude;
+        }
+        sink=sink+acc;
+    }));
+
+    // whole searches: the plain calls copy their result out of the thread's
+    // SearchWorkspace, the workspace calls leave it there
+    int searches=max(1,min(queries/1000,200));
+    out["results"].push_back(measure("dijkstra",searches,[&](int q) {
+        sink=sink+dijkstra(g,nodes[q]).size();
+    }));
+    SearchWorkspace ws;
+    dijkstra(g,nodes[0],ws); // grow the buffers outside the measurement
+    out["results"].push_back(measure("dijkstra_workspace",searches,[&](int q) {
+        dijkstra(g,nodes[q],ws);
+        sink=sink+ws.dist(nodes[(q+1)%queries]);
+    }));
+    out["results"].push_back(measure("dijkstraToTargets_workspace",searches,[&](int q) {
+        dijkstraToTargets(g,nodes[q],{nodes[(q+1)%queries]},ws);
+        sink=sink+ws.dist(nodes[(q+1)%queries]);
+    }));
+    out["results"].push_back(measure("aStarPath",searches,[&](int q) {
+        sink=sink+aStarPath(g,nodes[q],nodes[(q+1)%queries]).size();
+    }));
+
+    cout<<out.dump(2)<<endl;
+    return 0;
+}
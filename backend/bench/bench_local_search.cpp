@@ -0,0 +1,78 @@
+// Tour improvement from the same MST preorder start: full-sweep
+// twoOptImprovement vs the neighbor-list localSearch pipeline (2-opt,
+// Or-opt, 3-opt segment exchange) for 30..500 stops on a synthetic grid,
+// plus tspMultiStart (16 seeded starts on the shared pool) and
+// tspLinKernighan with its default 100 ms budget.
+// Reports wall time and resulting tour length for each.
+//
+//   make bench && ./bench/bin/bench_local_search [rows cols]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/json.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 80;
+    int cols=argc>2 ? atoi(argv[2]) : 80;
+
+    Graph g;
+    buildGridGraph(g,rows,cols,42);
+    int n=g.csr().numNodes;
+    mt19937 rng(5);
+
+    json out;
+    out["graph"]={{"nodes",n},{"rows",rows},{"cols",cols}};
+    out["results"]=json::array();
+    for (int stops:{30,50,100,200,500}) {
+        vector<int> locs;
+        while ((int)locs.size()<stops) {
+            int v=(int)(rng()%n);
+            if (find(locs.begin(),locs.end(),v)==locs.end()) locs.push_back(v);
+        }
+        DistanceMatrix dist=buildDistanceMatrix(g,locs);
+        vector<Edge> edges;
+        for (int i=0; i<stops; ++i)
+            for (int j=i+1; j<stops; ++j) edges.push_back({i,j,dist[i][j]});
+        vector<int> start=mstToTour(kruskalMST(edges,stops),stops,0);
+
+        vector<int> twoOpt=start;
+        long long t0=nowNs();
+        twoOptImprovement(twoOpt,dist);
+        double twoOptMs=(nowNs()-t0)/1e6;
+
+        vector<int> pipeline=start;
+        t0=nowNs();
+        localSearch(pipeline,dist);
+        double pipelineMs=(nowNs()-t0)/1e6;
+
+        t0=nowNs();
+        pair<double,vector<int>> multi=tspMultiStart(dist);
+        double multiMs=(nowNs()-t0)/1e6;
+
+        t0=nowNs();
+        pair<double,vector<int>> lk=tspLinKernighan(dist);
+        double lkMs=(nowNs()-t0)/1e6;
+
+        json r;
+        r["stops"]=stops;
+        r["mst_tour"]=tourLength(start,dist);
+        r["twoOpt_tour"]=tourLength(twoOpt,dist);
+        r["twoOpt_ms"]=twoOptMs;
+        r["localSearch_tour"]=tourLength(pipeline,dist);
+        r["localSearch_ms"]=pipelineMs;
+        r["multiStart_tour"]=multi.first;
+        r["multiStart_ms"]=multiMs;
+        r["linKernighan_tour"]=lk.first;
+        r["linKernighan_ms"]=lkMs;
+        out["results"].push_back(r);
+    }
+    cout<<out.dump(2)<<endl;
+    return 0;
+}
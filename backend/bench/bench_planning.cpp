@@ -0,0 +1,215 @@
+// Checks and timings for the itinerary solvers on stops picked from the
+// bench graph (buildBenchGraph), with the stops' own visit durations, fees
+// and ratings. Each solver's result is re-verified independently:
+//   orienteering: the route starts at stop 0, visits each stop once and its
+//     recomputed time, fees and prize match the result and fit the budgets.
+//   tspTimeWindows: on 8 stops with random opening hours, the exact finish
+//     equals the best of all 7! orders tried by brute force (or both find
+//     none), and the returned schedule replays to that finish.
+//   planDays: min(k, n-1) days, each starting at stop 0, every other stop in
+//     exactly one day, and each day's time equal to its travel plus service.
+// Reports wall time per case; exits 1 on any violation.
+//
+//   make bench && ./bench/bin/bench_planning [rows cols]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+static const double CHECK_EPS=1e-6;
+static int violations=0;
+
+static void fail(const string& what) {
+    cerr<<"VIOLATION: "<<what<<"\n";
+    ++violations;
+}
+
+// finish of the open path in `order` from startTime, infinity if a visit fits no window
+static double replay(const DistanceMatrix& dist,const vector<double>& service,const vector<OpenWindows>& windows,
+                     double startTime,const vector<int>& order,vector<double>* starts=nullptr) {
+    double t=startTime;
+    if (starts) starts->assign(1,startTime);
+    for (size_t i=1; i<order.size(); ++i) {
+        int k=order[i];
+        double s=earliestVisit(windows[k],t+dist[order[i-1]][k],service[k]);
+        if (s==INFINITY) return INFINITY;
+        if (starts) starts->push_back(s);
+        t=s+service[k];
+    }
+    return t;
+}
+
+static vector<int> pickStops(int n,int k,mt19937& rng) {
+    vector<int> locs;
+    while ((int)locs.size()<k) {
+        int v=(int)(rng()%n);
+        if (find(locs.begin(),locs.end(),v)==locs.end()) locs.push_back(v);
+    }
+    return locs;
+}
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 60;
+    int cols=argc>2 ? atoi(argv[2]) : 60;
+
+    Graph g;
+    buildBenchGraph(g,rows,cols,42);
+    int n=g.csr().numNodes;
+    mt19937 rng(9);
+
+    json out;
+    out["graph"]={{"nodes",n}};
+    out["orienteering"]=json::array();
+
+    for (int stops:{20,40}) {
+        for (double timeBudget:{90.0,180.0,360.0}) {
+            vector<int> locs=pickStops(n,stops,rng);
+            DistanceMatrix dist=buildDistanceMatrix(g,locs);
+            vector<double> service,prize,fee;
+            for (int id:locs) {
+                const Attraction& a=g.getAttraction(id);
+                service.push_back(a.visitDuration);
+                prize.push_back(a.rating*a.popularity/100.0);
+                fee.push_back(a.entryFee);
+            }
+            // unlimited, then room for only a few paid stops past the start
+            for (double feeBudget:{(double)INFINITY,fee[0]+60}) {
+                long long t0=nowNs();
+                OrienteeringResult r=orienteering(dist,service,prize,fee,timeBudget,feeBudget);
+                double ms=(nowNs()-t0)/1e6;
+
+                string at="orienteering "+to_string(stops)+" stops, budget "+to_string((int)timeBudget)+": ";
+                vector<char> seen(stops,0);
+                double time=0,fees=0,got=0;
+                for (size_t i=0; i<r.order.size(); ++i) {
+                    int x=r.order[i];
+                    if (x<0 || x>=stops || seen[x]) { fail(at+"bad or repeated stop"); break; }
+                    seen[x]=1;
+                    if (i>0) time+=dist[r.order[i-1]][x];
+                    time+=service[x]; fees+=fee[x]; got+=prize[x];
+                }
+                if (!r.order.empty() && r.order[0]!=0) fail(at+"does not start at stop 0");
+                if (time>timeBudget+CHECK_EPS) fail(at+"over the time budget");
+                if (fees>feeBudget+CHECK_EPS) fail(at+"over the fee budget");
+                if (fabs(time-r.time)>CHECK_EPS || fabs(fees-r.fees)>CHECK_EPS || fabs(got-r.prize)>CHECK_EPS)
+                    fail(at+"reported totals do not match the route");
+
+                json e;
+                e["stops"]=stops;
+                e["timeBudget"]=timeBudget;
+                e["feeBudget"]=isinf(feeBudget) ? json(nullptr) : json(feeBudget);
+                e["visited"]=r.order.size();
+                e["prize"]=r.prize;
+                e["time"]=r.time;
+                e["ms"]=ms;
+                out["orienteering"].push_back(e);
+            }
+        }
+    }
+
+    // about a third always open, the rest one or two windows between 8:00 and 20:00
+    out["timeWindows"]=json::array();
+    const double dayStart=8*60;
+    int feasible=0;
+    for (int trial=0; trial<40; ++trial) {
+        const int stops=8;
+        vector<int> locs=pickStops(n,stops,rng);
+        DistanceMatrix dist=buildDistanceMatrix(g,locs);
+        vector<double> service;
+        vector<OpenWindows> windows(stops);
+        for (int k=0; k<stops; ++k) {
+            service.push_back(g.getAttraction(locs[k]).visitDuration);
+            if (k==0 || rng()%3==0) continue;
+            double open=dayStart+(rng()%360);
+            windows[k].push_back({open,open+60+(rng()%180)});
+            if (rng()%2 && windows[k][0].second+30<20*60) {
+                double again=windows[k][0].second+30+(rng()%120);
+                windows[k].push_back({again,min(20.0*60,again+60+(rng()%120))});
+            }
+        }
+        long long t0=nowNs();
+        ScheduledTour tw=tspTimeWindows(dist,service,windows,dayStart);
+        double ms=(nowNs()-t0)/1e6;
+
+        vector<int> order(stops);
+        for (int k=0; k<stops; ++k) order[k]=k;
+        double best=INFINITY;
+        do best=min(best,replay(dist,service,windows,dayStart,order));
+        while (next_permutation(order.begin()+1,order.end()));
+
+        string at="time windows trial "+to_string(trial)+": ";
+        if (!tw.exact) fail(at+"8 stops should be solved exactly");
+        if (tw.order.empty() != (best==INFINITY)) {
+            fail(at+"exact and brute force disagree on feasibility");
+        } else if (!tw.order.empty()) {
+            ++feasible;
+            vector<double> starts;
+            double finish=replay(dist,service,windows,dayStart,tw.order,&starts);
+            if (fabs(tw.finish-best)>CHECK_EPS) fail(at+"exact finish is not the brute-force optimum");
+            if (fabs(finish-tw.finish)>CHECK_EPS) fail(at+"schedule does not replay to its finish");
+            if (starts.size()!=tw.starts.size()) fail(at+"one visit start per stop expected");
+            else
+                for (size_t i=0; i<starts.size(); ++i)
+                    if (fabs(starts[i]-tw.starts[i])>CHECK_EPS) { fail(at+"visit starts differ from the replay"); break; }
+        }
+        json e;
+        e["trial"]=trial;
+        e["finish"]=tw.order.empty() ? json(nullptr) : json(tw.finish);
+        e["ms"]=ms;
+        out["timeWindows"].push_back(e);
+    }
+    out["timeWindowsFeasible"]=feasible;
+
+    out["planDays"]=json::array();
+    for (int stops:{12,30,60}) {
+        for (int k:{1,3,7,100}) {
+            vector<int> locs=pickStops(n,stops,rng);
+            DistanceMatrix dist=buildDistanceMatrix(g,locs);
+            vector<double> service;
+            for (int id:locs) service.push_back(g.getAttraction(id).visitDuration);
+            double dayLimit=k==3 ? 240 : INFINITY;
+            long long t0=nowNs();
+            vector<DayRoute> plan=planDays(dist,service,k,dayLimit);
+            double ms=(nowNs()-t0)/1e6;
+
+            string at="planDays "+to_string(stops)+" stops, "+to_string(k)+" days: ";
+            if ((int)plan.size()!=min(k,stops-1)) fail(at+"wrong number of days");
+            vector<int> seen(stops,0);
+            double longest=0;
+            for (const DayRoute& day:plan) {
+                if (day.order.empty() || day.order[0]!=0) { fail(at+"a day does not start at stop 0"); continue; }
+                double time=0;
+                for (size_t i=1; i<day.order.size(); ++i) {
+                    int x=day.order[i];
+                    if (x<=0 || x>=stops) { fail(at+"bad stop"); break; }
+                    ++seen[x];
+                    time+=dist[day.order[i-1]][x]+service[x];
+                }
+                if (fabs(time-day.time)>CHECK_EPS) fail(at+"day time does not match its route");
+                longest=max(longest,day.time);
+            }
+            for (int x=1; x<stops; ++x)
+                if (seen[x]!=1) { fail(at+"stop "+to_string(x)+" planned "+to_string(seen[x])+" times"); break; }
+
+            json e;
+            e["stops"]=stops;
+            e["days"]=k;
+            e["dayLimit"]=isinf(dayLimit) ? json(nullptr) : json(dayLimit);
+            e["longestDay"]=longest;
+            e["ms"]=ms;
+            out["planDays"].push_back(e);
+        }
+    }
+
+    out["violations"]=violations;
+    cout<<out.dump(2)<<endl;
+    return violations==0 ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+// Startup cost: loadFromCSV on a synthetic grid written out as
+// attractions/roads CSVs vs loadSnapshot of the same graph, plus a check
+// that both give the same CSR and name lookups.
+//
+//   make bench && ./bench/bin/bench_snapshot [rows cols]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/json.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+using json = nlohmann::json;
+using namespace std;
+
+static bool sameGraph(const Graph& a,const Graph& b) {
+    CSRView x=a.csr(),y=b.csr();
+    if (x.numNodes!=y.numNodes) return false;
+    for (int u=0; u<=x.numNodes; ++u) if (x.offsets[u]!=y.offsets[u]) return false;
+    for (int e=0; e<x.offsets[x.numNodes]; ++e)
+        if (x.targets[e]!=y.targets[e] || x.weights[e]!=y.weights[e]) return false;
+    for (int u=0; u<x.numNodes; ++u)
+        if (b.getIdByName(a.getAttraction(u).name)!=u) return false;
+    return true;
+}
+
+int main(int argc,char** argv) {
+    int rows=argc>2 ? atoi(argv[1]) : 300;
+    int cols=argc>2 ? atoi(argv[2]) : 300;
+    string attractionsFile="bench_snapshot_attractions.csv",roadsFile="bench_snapshot_roads.csv";
+    string snapFile="bench_snapshot.snap";
+
+    {
+        Graph g;
+        buildGridGraph(g,rows,cols,42);
+        g.saveCSV(attractionsFile,roadsFile);
+    }
+    json out;
+    out["results"]=json::array();
+
+    Graph fromCSV;
+    long long a0=allocCount(),t0=nowNs();
+    fromCSV.loadFromCSV(attractionsFile,roadsFile);
+    long long t1=nowNs(),a1=allocCount();
+    out["graph"]={{"nodes",fromCSV.csr().numNodes},{"rows",rows},{"cols",cols}};
+    out["results"].push_back({{"name","loadFromCSV"},{"ms",(t1-t0)/1e6},{"allocs",a1-a0}});
+
+    t0=nowNs();
+    bool saved=fromCSV.saveSnapshot(snapFile);
+    out["results"].push_back({{"name","saveSnapshot"},{"ms",(nowNs()-t0)/1e6},{"ok",saved}});
+
+    Graph fromSnap;
+    a0=allocCount(); t0=nowNs();
+    bool loaded=fromSnap.loadSnapshot(snapFile);
+    t1=nowNs(); a1=allocCount();
+    out["results"].push_back({{"name","loadSnapshot"},{"ms",(t1-t0)/1e6},{"allocs",a1-a0},{"ok",loaded}});
+    out["identical"]=loaded && sameGraph(fromCSV,fromSnap);
+
+    remove(attractionsFile.c_str());
+    remove(roadsFile.c_str());
+    remove(snapFile.c_str());
+    cout<<out.dump(2)<<"\n";
+    return out["identical"].get<bool>() ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+// Regression suite over the algorithms.h entry points: dijkstra,
+// dijkstraWithPath, aStarPath and kruskalMST on generated graphs (road-like
+// by default) of 10^4 .. maxNodes nodes, loadFromCSV of the same graphs, and
+// tspDP, tspMSTApproximation, greedyTSP and twoOptImprovement on stop sets
+// of growing size. Every entry reports ns/op with p50/p90/p99, heap
+// allocations and bytes per op, and nodes settled where a search settles
+// any, as one JSON document keyed by name + size for diffing between runs.
+//
+//   make bench-suite                       (writes bench/bin/suite.json)
+//   ./bench/bin/bench_suite [maxNodes [grid|geometric|road]]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/graph_generator.h"
+#include "../include/algorithms.h"
+#include "../include/json.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+// Runs setup(i) untimed, then op(i) timed, for i in [0, reps). op returns
+// the nodes it settled, or -1 when that does not apply.
+static json measure(const string& name,const json& size,int reps,const function<void(int)>& setup,
+                    const function<long long(int)>& op) {
+    vector<double> samples;
+    samples.reserve(reps);
+    long long allocs=0,bytes=0,settled=0;
+    bool searches=false;
+    for (int i=0; i<reps; ++i) {
+        if (setup) setup(i);
+        long long a0=allocCount(),b0=allocBytes(),t0=nowNs();
+        long long s=op(i);
+        samples.push_back((double)(nowNs()-t0));
+        allocs+=allocCount()-a0;
+        bytes+=allocBytes()-b0;
+        if (s>=0) { settled+=s; searches=true; }
+    }
+    double total=0;
+    for (double s:samples) total+=s;
+    json r;
+    r["name"]=name;
+    r["size"]=size;
+    r["reps"]=reps;
+    r["ns_per_op"]=total/reps;
+    r["p50_ns"]=percentile(samples,50);
+    r["p90_ns"]=percentile(samples,90);
+    r["p99_ns"]=percentile(samples,99);
+    r["allocs_per_op"]=(double)allocs/reps;
+    r["bytes_per_op"]=(double)bytes/reps;
+    if (searches) r["settled_per_op"]=(double)settled/reps;
+    cerr<<name<<" "<<size.dump()<<": "<<total/reps/1e6<<" ms/op\n";
+    return r;
+}
+
+static double pathCost(const Graph& g,const vector<int>& path) {
+    double c=0;
+    for (size_t i=1; i<path.size(); ++i) c+=g.getEdgeWeight(path[i-1],path[i]);
+    return c;
+}
+
+int main(int argc,char** argv) {
+    int maxNodes=argc>1 ? atoi(argv[1]) : 1000000;
+    string shape=argc>2 ? argv[2] : "road";
+    const unsigned seed=42;
+    mt19937 rng(11);
+
+    json out;
+    out["suite"]="algorithms";
+    out["shape"]=shape;
+    out["seed"]=seed;
+    out["results"]=json::array();
+    int mismatches=0;
+
+    // graph algorithms: fewer reps as the graph grows, at least 5
+    for (int nodes=10000; nodes<=maxNodes; nodes*=10) {
+        Graph g;
+        if (!generateGraph(g,shape,nodes,seed)) {
+            cerr<<"unknown shape: "<<shape<<"\n";
+            return 2;
+        }
+        CSRView c=g.csr();
+        int n=c.numNodes;
+        json size={{"nodes",n},{"roads",c.offsets[n]/2}};
+        int reps=max(5,(int)(200000/n));
+        vector<int> from(reps),to(reps);
+        for (int i=0; i<reps; ++i) { from[i]=(int)(rng()%n); to[i]=(int)(rng()%n); }
+        auto reachable=[](const vector<double>& d) {
+            return (long long)count_if(d.begin(),d.end(),[](double x) { return x<INFINITY; });
+        };
+
+        vector<vector<double>> exact(reps);
+        out["results"].push_back(measure("dijkstra",size,reps,nullptr,[&](int i) {
+            exact[i]=dijkstra(g,from[i]);
+            return reachable(exact[i]);
+        }));
+        out["results"].push_back(measure("dijkstraWithPath",size,reps,nullptr,[&](int i) {
+            auto res=dijkstraWithPath(g,from[i]);
+            return reachable(res.first);
+        }));
+        out["results"].push_back(measure("aStarPath",size,reps,nullptr,[&](int i) {
+            int settled=0;
+            vector<int> path=aStarPath(g,from[i],to[i],&settled);
+            double want=exact[i][to[i]];
+            if (path.empty() ? want<INFINITY : fabs(pathCost(g,path)-want)>1e-6) ++mismatches;
+            return (long long)settled;
+        }));
+
+        vector<Edge> edges=g.getAllEdges(),work;
+        out["results"].push_back(measure("kruskalMST",size,max(3,reps/4),[&](int) { work=edges; },[&](int) {
+            kruskalMST(work,n);
+            return -1LL;
+        }));
+
+        string attractionsFile="bench_suite_attractions.csv",roadsFile="bench_suite_roads.csv";
+        g.saveCSV(attractionsFile,roadsFile);
+        out["results"].push_back(measure("loadFromCSV",size,3,nullptr,[&](int) {
+            Graph h;
+            h.loadFromCSV(attractionsFile,roadsFile);
+            return -1LL;
+        }));
+        remove(attractionsFile.c_str());
+        remove(roadsFile.c_str());
+    }
+
+    // tour algorithms on stops picked from a 10^4 node graph
+    Graph g;
+    generateGraph(g,shape,10000,seed);
+    int n=g.csr().numNodes;
+    auto pickStops=[&](int k) {
+        vector<int> locs;
+        while ((int)locs.size()<k) {
+            int v=(int)(rng()%n);
+            if (find(locs.begin(),locs.end(),v)==locs.end()) locs.push_back(v);
+        }
+        return buildDistanceMatrix(g,locs);
+    };
+    for (int stops:{8,12,16}) {
+        DistanceMatrix dist=pickStops(stops);
+        out["results"].push_back(measure("tspDP",{{"stops",stops}},stops<16 ? 20 : 5,nullptr,[&](int) {
+            tspDP(dist);
+            return -1LL;
+        }));
+    }
+    for (int stops:{20,50,100,200}) {
+        DistanceMatrix dist=pickStops(stops);
+        int reps=max(5,2000/stops);
+        json size={{"stops",stops}};
+        // 2-opt from the stops' own (random) order: the MST tour comes back
+        // already 2-opt polished and would leave nothing to improve
+        vector<int> start(stops),tour;
+        for (int i=0; i<stops; ++i) start[i]=i;
+        out["results"].push_back(measure("tspMSTApproximation",size,reps,nullptr,[&](int) {
+            tspMSTApproximation(dist);
+            return -1LL;
+        }));
+        out["results"].push_back(measure("greedyTSP",size,reps,nullptr,[&](int) {
+            greedyTSP(dist);
+            return -1LL;
+        }));
+        out["results"].push_back(measure("twoOptImprovement",size,max(3,reps/10),[&](int) { tour=start; },[&](int) {
+            twoOptImprovement(tour,dist);
+            return -1LL;
+        }));
+    }
+    out["mismatches"]=mismatches;
+    cout<<out.dump(2)<<endl;
+    return mismatches==0 ? 0 : 1;
+}
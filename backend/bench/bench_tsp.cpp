@@ -0,0 +1,74 @@
+// Exact TSP: serial tspDP with the scalar and the runtime-selected (AVX2)
+// min-plus kernel vs layer-parallel tspDPParallel on the shared ThreadPool,
+// for stop counts 14..20 picked at random on a synthetic grid. Reports the
+// best-of-`reps` wall time per variant and checks that all return the same tour.
+//
+//   make bench && ./bench/bin/bench_tsp [minStops maxStops reps]
+
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/thread_pool.h"
+#include "../include/json.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+using json = nlohmann::json;
+using namespace std;
+
+static double bestMs(int reps,const function<void()>& op) {
+    double best=1e300;
+    for (int r=0; r<reps; ++r) {
+        long long t0=nowNs();
+        op();
+        best=min(best,(nowNs()-t0)/1e6);
+    }
+    return best;
+}
+
+int main(int argc,char** argv) {
+    int minStops=argc>2 ? atoi(argv[1]) : 14;
+    int maxStops=argc>2 ? atoi(argv[2]) : 20;
+    int reps=argc>3 ? atoi(argv[3]) : 3;
+
+    Graph g;
+    buildGridGraph(g,60,60,42);
+    int n=g.csr().numNodes;
+    mt19937 rng(3);
+
+    json out;
+    out["threads"]=ThreadPool::shared().size();
+    out["kernel"]=activeMinPlusKernel();
+    out["results"]=json::array();
+    int mismatches=0;
+    for (int stops=minStops; stops<=maxStops; stops+=2) {
+        vector<int> locs;
+        while ((int)locs.size()<stops) {
+            int v=(int)(rng()%n);
+            if (find(locs.begin(),locs.end(),v)==locs.end()) locs.push_back(v);
+        }
+        DistanceMatrix dist=buildDistanceMatrix(g,locs);
+        pair<double,vector<int>> scalar,serial,parallel;
+        setMinPlusKernel(MinPlusKernel::Scalar);
+        double scalarMs=bestMs(reps,[&] { scalar=tspDP(dist); });
+        setMinPlusKernel(MinPlusKernel::Auto);
+        double serialMs=bestMs(reps,[&] { serial=tspDP(dist); });
+        double parallelMs=bestMs(reps,[&] { parallel=tspDPParallel(dist); });
+        if (serial!=parallel || serial!=scalar) ++mismatches;
+        json r;
+        r["stops"]=stops;
+        r["table_mb"]=heldKarpTableBytes(stops)/1048576.0;
+        r["tspDP_scalar_ms"]=scalarMs;
+        r["tspDP_ms"]=serialMs;
+        r["kernel_speedup"]=serialMs>0 ? scalarMs/serialMs : 0;
+        r["tspDPParallel_ms"]=parallelMs;
+        r["speedup"]=parallelMs>0 ? serialMs/parallelMs : 0;
+        r["tour_minutes"]=serial.first;
+        out["results"].push_back(r);
+    }
+    out["mismatches"]=mismatches;
+    cout<<out.dump(2)<<endl;
+    return 0;
+}
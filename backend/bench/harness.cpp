@@ -0,0 +1,71 @@
+#include "harness.h"
+#include "../include/graph.h"
+#include "../include/graph_generator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+using namespace std;
+
+static atomic<long long> gAllocCount{0};
+static atomic<long long> gAllocBytes{0};
+
+void* operator new(size_t sz) {
+    gAllocCount.fetch_add(1,memory_order_relaxed);
+    gAllocBytes.fetch_add((long long)sz,memory_order_relaxed);
+    if (void* p=malloc(sz ? sz : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p,size_t) noexcept { free(p); }
+
+long long allocCount() { return gAllocCount.load(memory_order_relaxed); }
+long long allocBytes() { return gAllocBytes.load(memory_order_relaxed); }
+
+long long nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double percentile(vector<double>& samples,double p) {
+    if (samples.empty()) return 0;
+    sort(samples.begin(),samples.end());
+    size_t idx=(size_t)((p/100.0)*(samples.size()-1)+0.5);
+    return samples[min(idx,samples.size()-1)];
+}
+
+void buildGridGraph(Graph& g,int rows,int cols,unsigned seed) {
+    generateGrid(g,rows,cols,seed);
+}
+
+bool loadGraphFile(Graph& g,const string& path) {
+    auto endsWith=[&](const string& ext) {
+        return path.size()>=ext.size() && path.compare(path.size()-ext.size(),ext.size(),ext)==0;
+    };
+    if (endsWith(".snap")) return g.loadSnapshot(path);
+    if (endsWith(".gr")) {
+        string co=path.substr(0,path.size()-3)+".co";
+        return g.loadFromDIMACS(path,ifstream(co).good() ? co : "");
+    }
+    return g.loadFromEdgeList(path);
+}
+
+void buildBenchGraph(Graph& g,int rows,int cols,unsigned seed) {
+    const char* file=getenv("BENCH_GRAPH");
+    if (!file || !*file) {
+        buildGridGraph(g,rows,cols,seed);
+        return;
+    }
+    string spec=file;
+    size_t colon=spec.find(':');
+    if (colon!=string::npos && spec.find_first_not_of("0123456789",colon+1)==string::npos) {
+        if (generateGraph(g,spec.substr(0,colon),atoi(spec.c_str()+colon+1),seed)) return;
+    } else if (loadGraphFile(g,file)) {
+        return;
+    }
+    cerr<<"cannot load BENCH_GRAPH="<<file<<"\n";
+    exit(1);
+}
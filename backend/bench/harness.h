@@ -0,0 +1,38 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+// Shared helpers for the bench/ executables (built by `make bench`).
+// harness.cpp replaces the global operator new so every benchmark can
+// report how many heap allocations an operation performs.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Graph;
+
+// Heap allocations / bytes requested since program start.
+long long allocCount();
+long long allocBytes();
+
+// Monotonic clock in nanoseconds.
+long long nowNs();
+
+// Sort `samples` and return the p-th percentile (p in [0,100]).
+double percentile(std::vector<double>& samples, double p);
+
+// rows x cols grid of attractions ~100 m apart with 4-neighbor roads
+// weighted 1-3 minutes (generateGrid). Deterministic for a given seed.
+void buildGridGraph(Graph& g, int rows, int cols, unsigned seed);
+
+// Load a benchmark graph file by extension: .snap snapshot, .gr DIMACS (with
+// the .co next to it when present), anything else a whitespace edge list.
+bool loadGraphFile(Graph& g, const std::string& path);
+
+// The grid above, unless BENCH_GRAPH is set: "<shape>:<nodes>" generates a
+// synthetic graph (generateGraph, same seed), anything else is a file for
+// loadGraphFile. Lets the routing benches run at other shapes and scales,
+// or on imported road networks. Exits if it fails.
+void buildBenchGraph(Graph& g, int rows, int cols, unsigned seed);
+
+#endif // BENCH_HARNESS_H
@@ -3,27 +3,179 @@
 
 // forward declare Graph to avoid circular include with graph.h(very important)
 class Graph;
+class LandmarkIndex;
+class SearchWorkspace;
+class ThreadPool;
 
+#include <chrono>
+#include <string>
 #include <vector>
 #include <utility>
+#include <limits>
+#include <cstddef>
+
+#include "attraction.h"   // OpenWindows
+
+// Every search also has a SearchWorkspace overload:labels stay in the workspace
+//(ws.dist(v),ws.parent(v),ws.path(s,t)) instead of fresh O(n) vectors per call.
+//The plain versions run on SearchWorkspace::forThread() and copy the result out
 
 // Dijkstra Algorithm(one for indivigual path,other is fur multiple paths required)
 std::vector<double> dijkstra(const Graph& g, int start);
+void dijkstra(const Graph& g, int start, SearchWorkspace& ws);
 std::pair<std::vector<double>, std::vector<int>> dijkstraWithPath(const Graph& g, int start);
 std::vector<int> reconstructPath(const std::vector<int>& parent, int start, int end);
+// Target-aware Dijkstra:stops once every target is settled or the frontier passes maxDist.
+//Only settled vertices keep their distance/parent,everything else reads infinity/-1,
+//so a finite dist[t] is always exact and reconstructPath works for it
+std::pair<std::vector<double>, std::vector<int>> dijkstraToTargets(const Graph& g, int start, const std::vector<int>& targets,
+    double maxDist = std::numeric_limits<double>::infinity());
+//workspace form keeps tentative labels too:check ws.settled(v) before trusting ws.dist(v)
+void dijkstraToTargets(const Graph& g, int start, const std::vector<int>& targets, SearchWorkspace& ws,
+    double maxDist = std::numeric_limits<double>::infinity());
 // A*
 //essentially dijkstra with heuristic /goal to essentially cut short decision of paths to
 //optimize
-std::vector<int> aStarPath(const Graph& g, int start, int goal);
+//`settled` (optional) receives how many nodes were expanded
+std::vector<int> aStarPath(const Graph& g, int start, int goal, int* settled = nullptr);
+// ALT variant:landmark lower bounds(admissible, in minutes like the edge weights)
+std::vector<int> aStarPath(const Graph& g, int start, int goal, const LandmarkIndex& landmarks, int* settled = nullptr);
+std::vector<int> aStarPath(const Graph& g, int start, int goal, SearchWorkspace& ws, int* settled = nullptr);
+std::vector<int> aStarPath(const Graph& g, int start, int goal, const LandmarkIndex& landmarks, SearchWorkspace& ws,
+    int* settled = nullptr);
 double haversine(double lat1, double lon1, double lat2, double lon2);
 
+// Bidirectional point-to-point search:{time,path start..goal};infinite time,empty path if unreachable
+//A* variant uses averaged ALT potentials so the bidirectional stopping rule stays exact
+std::pair<double, std::vector<int>> bidirectionalDijkstra(const Graph& g, int start, int goal, int* settled = nullptr);
+std::pair<double, std::vector<int>> bidirectionalAStar(const Graph& g, int start, int goal, const LandmarkIndex& landmarks, int* settled = nullptr);
+//one workspace per direction
+std::pair<double, std::vector<int>> bidirectionalDijkstra(const Graph& g, int start, int goal,
+    SearchWorkspace& fwd, SearchWorkspace& bwd, int* settled = nullptr);
+std::pair<double, std::vector<int>> bidirectionalAStar(const Graph& g, int start, int goal, const LandmarkIndex& landmarks,
+    SearchWorkspace& fwd, SearchWorkspace& bwd, int* settled = nullptr);
+
+// Many-to-many distance table between selected locations
+//dist[i][j]=shortest time locs[i]->locs[j];built once per request and shared by every TSP strategy
+typedef std::vector<std::vector<double>> DistanceMatrix;
+DistanceMatrix buildDistanceMatrix(const Graph& g, const std::vector<int>& locs);
+DistanceMatrix buildDistanceMatrix(const Graph& g, const std::vector<int>& locs, SearchWorkspace& ws);
+
 // TSP
 //travelling salesman problem(2 opt improvement,along with greedy algorithm part)
+//tspDP=exact Held-Karp over open paths from stop 0;flat float table+8 bit parents,
+//gives {inf,empty} when the table would need more than HELD_KARP_MAX_BYTES (23+ stops)
+const size_t HELD_KARP_MAX_BYTES = (size_t)128 << 20;
+size_t heldKarpTableBytes(int n);
 std::pair<double, std::vector<int>> tspDP(const std::vector<std::vector<double>>& dist);
+//Held-Karp inner loop:AVX2 min-plus kernel when the CPU supports it(checked at runtime),
+//scalar otherwise;both give identical tours. Forcing Scalar is for benchmarks/tests
+enum class MinPlusKernel { Auto, Scalar };
+void setMinPlusKernel(MinPlusKernel kernel);
+const char* activeMinPlusKernel();
+//same table filled one popcount layer at a time on a thread pool;identical result to tspDP
+std::pair<double, std::vector<int>> tspDPParallel(const std::vector<std::vector<double>>& dist);
+std::pair<double, std::vector<int>> tspDPParallel(const std::vector<std::vector<double>>& dist, ThreadPool& pool);
 std::pair<double, std::vector<int>> tspMSTApproximation(const Graph& g, const std::vector<int>& locs);
+std::pair<double, std::vector<int>> tspMSTApproximation(const DistanceMatrix& dist);
 std::pair<double, std::vector<int>> greedyTSP(const Graph& g, int start, const std::vector<int>& locs);
+std::pair<double, std::vector<int>> greedyTSP(const DistanceMatrix& dist);
 void twoOptImprovement(std::vector<int>& tour, const std::vector<std::vector<double>>& dist);
+// Local search pipeline over open tours(tour[0] stays first,tour visits every index of dist).
+//Each stage only tries moves towards a stop's k nearest neighbors and keeps don't-look bits,
+//so converged stops cost nothing;localSearch reruns the stages until none improves
+enum class TourMove { TwoOpt, OrOpt, ThreeOpt };
+std::vector<std::vector<int>> nearestNeighbors(const DistanceMatrix& dist, int k);
+bool localSearchStage(std::vector<int>& tour, const DistanceMatrix& dist, const std::vector<std::vector<int>>& nbrs, TourMove move);
+void localSearch(std::vector<int>& tour, const DistanceMatrix& dist,
+    const std::vector<TourMove>& pipeline = {TourMove::TwoOpt, TourMove::OrOpt, TourMove::ThreeOpt}, int neighbors = 10);
+
+// Lin-Kernighan style engine for large stop sets:MST tour+local search,then LK chains of
+//2-opt moves over a candidate set plus Or-opt,then double-bridge kicks until the time
+//limit/kick budget runs out. Candidates are alpha-nearness(from the MST) or plain nearest neighbors
+struct LinKernighanOptions {
+    int timeLimitMs = 100;
+    int maxKicks = -1;          // -1:kick until timeLimitMs
+    int candidates = 6;
+    bool alphaNearness = true;
+    int maxDepth = 6;           // 2-opt steps per LK chain
+    unsigned seed = 1;
+};
+std::vector<std::vector<int>> alphaNearnessCandidates(const DistanceMatrix& dist, int k);
+std::pair<double, std::vector<int>> tspLinKernighan(const DistanceMatrix& dist, const LinKernighanOptions& opts = {});
+// Multi-start:`starts` tours from different seeds(MST preorders and greedy chains from other
+//roots,randomized cheapest insertion),each polished by the local search pipeline on the pool,
+//best kept. Start t only depends on(seed,t),so a fixed seed gives the same tour on any core count
+struct MultiStartOptions {
+    int starts = 16;
+    unsigned seed = 1;
+};
+std::pair<double, std::vector<int>> tspMultiStart(const DistanceMatrix& dist, const MultiStartOptions& opts = {});
+std::pair<double, std::vector<int>> tspMultiStart(const DistanceMatrix& dist, const MultiStartOptions& opts, ThreadPool& pool);
+double tourLength(const std::vector<int>& tour, const DistanceMatrix& dist);
+// Anytime solver:greedy,MST+2-opt,the local search pipeline,then exact Held-Karp(when the
+//table fits and its estimated fill time fits the time left) or Lin-Kernighan kicks,each only while the deadline allows. Returns the best tour
+//so far when the deadline hits;stage names the step that produced it
+struct AnytimeTour {
+    double length = 0;
+    std::vector<int> order;
+    std::string stage;   // "Greedy","MST + 2-opt","Local Search","Held-Karp" or "Lin-Kernighan"
+};
+AnytimeTour tspAnytime(const DistanceMatrix& dist, std::chrono::steady_clock::time_point deadline);
+//Flexible order without a deadline:exact Held-Karp up to FLEXIBLE_EXACT_MAX stops(milliseconds,a
+//few MiB),Lin-Kernighan with a 10n kick budget beyond(same route every time). The full table
+//range(22 stops,~128 MiB)is left to tspAnytime
+const int FLEXIBLE_EXACT_MAX = 16;
 std::pair<double, std::vector<int>> computeOptimalRouteFree(const Graph& g, const std::vector<int>& locs);
+std::pair<double, std::vector<int>> computeOptimalRouteFree(const DistanceMatrix& dist);
+
+// Orienteering:pick and order stops to collect the most prize within timeBudget(and feeBudget).
+//Stop 0 is the fixed start and always visited;the route is an open path from it and its time is
+//travel plus service(visit duration) of every stop on it. Greedy prize-per-minute insertion,then
+//local search to free time,refills and 1-for-1 exchanges until none helps.
+//Empty order if even the start alone breaks a budget
+struct OrienteeringResult {
+    std::vector<int> order;
+    double prize = 0;
+    double time = 0;
+    double fees = 0;
+};
+OrienteeringResult orienteering(const DistanceMatrix& dist, const std::vector<double>& service,
+    const std::vector<double>& prize, const std::vector<double>& fee, double timeBudget,
+    double feeBudget = std::numeric_limits<double>::infinity());
+
+// TSP with time windows(opening hours):the day starts at stop 0 at startTime(minutes after
+//midnight),every other stop is visited for service[k] minutes,entirely inside one of its
+//windows,waiting for it to open if early. Minimizes the finish time of the last visit.
+//Exact Held-Karp on earliest finish up to TIME_WINDOW_EXACT_MAX stops,insertion+relocate/
+//reversal moves beyond. Partial schedules that miss a window,or leave some stop unable to make
+//its last window,are dropped right there. Empty order if no feasible order was found
+const int TIME_WINDOW_EXACT_MAX = 16;
+struct ScheduledTour {
+    double finish = std::numeric_limits<double>::infinity();
+    std::vector<int> order;
+    std::vector<double> starts;   // visit start per order position(starts[0]=startTime)
+    bool exact = false;
+};
+//earliest time >= arrival a visit of `service` minutes fits a window,infinity if none
+double earliestVisit(const OpenWindows& windows, double arrival, double service);
+ScheduledTour tspTimeWindows(const DistanceMatrix& dist, const std::vector<double>& service,
+    const std::vector<OpenWindows>& windows, double startTime);
+
+// Multi-day itinerary(VRP):split stops 1..n-1 over k days that each start at stop 0. A day's
+//time is travel plus service of its stops;days over dayLimit are penalized hard,so the limit is
+//met whenever the moves find a way. k-medoids clusters,one tour per day(exact up to
+//FLEXIBLE_EXACT_MAX stops,LK beyond;days solved in parallel on the pool),then relocate/swap
+//moves between days,re-solving the changed days.
+//k is capped at max(n-1,1):a day per stop at most
+struct DayRoute {
+    std::vector<int> order;   // starts with 0;just {0} for a day without stops
+    double time = 0;
+};
+std::vector<DayRoute> planDays(const DistanceMatrix& dist, const std::vector<double>& service, int k,
+    double dayLimit = std::numeric_limits<double>::infinity());
+std::vector<DayRoute> planDays(const DistanceMatrix& dist, const std::vector<double>& service, int k,
+    double dayLimit, ThreadPool& pool);
 
 // Kruskal & MST
 struct Edge {
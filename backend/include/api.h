@@ -14,14 +14,56 @@ struct ApiResult {
     std::string errorMessage;
     std::vector<int> fullPath;
     std::vector<std::string> fullPathNames;
+    double score = 0.0;        // choice 5 only
+    double totalFee = 0.0;     // choice 5 only
+    std::vector<double> visitStarts;   // choice 1 with a start time only
+};
+
+// Engine selection plus any precomputed index it needs (owned by the caller,
+// built once per process in daemon mode)
+struct RoutingOptions {
+    PathEngine engine = PathEngine::Dijkstra;
+    const ContractionHierarchy* ch = nullptr;
+    const LandmarkIndex* landmarks = nullptr;   // ALT bounds for the full traversal
+    int timeBudgetMs = 0;                        // flexible order deadline, 0 = none
+    double startTime = -1;                       // flexible order opening hours, see RouteOptimizer::setStartTime
+    int multiStarts = 0;                         // flexible order multi-start tours, 0 = off, see RouteOptimizer::setMultiStart
+    unsigned multiStartSeed = 1;
 };
 
 // For choices 1 & 2 (TSP or Dijkstra)
 ApiResult runOptimizerAPI(
     int mode, 
     const std::vector<std::string>& locations,
-    Graph& graph
+    Graph& graph,
+    const RoutingOptions& options = RoutingOptions()
+);
+
+// For choice 5 (Orienteering): best rated stops from start within the budgets.
+// candidates empty means every attraction
+ApiResult runOrienteeringAPI(
+    const std::string& start,
+    const std::vector<std::string>& candidates,
+    double timeBudget,
+    double feeBudget,
+    Graph& graph,
+    const RoutingOptions& options = RoutingOptions()
+);
+
+// For choice 6 (Multi-day itinerary): locations[0] starts every day, the rest
+// are split over `days` routes of at most dayLimit minutes each where possible
+struct MultiDayResult {
+    bool success = false;
+    std::string errorMessage;
+    std::vector<ApiResult> days;
+};
+MultiDayResult runMultiDayAPI(
+    const std::vector<std::string>& locations,
+    int days,
+    double dayLimit,
+    Graph& graph,
+    const RoutingOptions& options = RoutingOptions()
 );
 
 // For choice 3 (Full campus traversal)
-ApiResult runFullGraphTraversal(Graph& graph);
+ApiResult runFullGraphTraversal(Graph& graph, const RoutingOptions& options = RoutingOptions());
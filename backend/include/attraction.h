@@ -2,8 +2,13 @@
 #define ATTRACTION_H
 
 #include <string>
+#include <utility>
 #include <vector>
 
+// Opening hours as [open, close] in minutes after midnight, sorted by open.
+// Empty means always open; a close past 1440 runs over midnight.
+typedef std::vector<std::pair<double, double>> OpenWindows;
+
 struct Attraction {
     int id;
     std::string name;
@@ -17,10 +22,19 @@ struct Attraction {
     std::vector<std::string> tags;
     std::string description;
     std::string openingHours;
+    OpenWindows openWindows;   // parsed openingHours
 
     Attraction()
         : id(-1), latitude(0), longitude(0),
           visitDuration(0), rating(0), entryFee(0), popularity(0) {}
 };
 
+// "HH:MM" (00:00 .. 24:00) as minutes after midnight; false if malformed
+bool parseClockTime(const std::string& text, double& minutes);
+
+// "09:00-17:00", several ranges separated by ';' ("09:00-12:00;14:00-18:00"),
+// or empty / "24/7" for always open. A range ending before it starts runs past
+// midnight. False (and windows left empty) if the text does not parse.
+bool parseOpeningHours(const std::string& text, OpenWindows& windows);
+
 #endif // ATTRACTION_H
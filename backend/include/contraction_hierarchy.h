@@ -0,0 +1,55 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <utility>
+#include <vector>
+#include "algorithms.h"
+
+class Graph;
+
+// Contraction Hierarchies over a frozen (CSR) Graph.
+// build() contracts vertices one at a time in edge-difference order and
+// inserts a shortcut u-w (remembering the contracted middle vertex) whenever
+// no witness path avoids it. Queries then only ever walk "upward" to higher
+// ranked vertices from both ends, which touches a tiny part of the graph.
+// Roads are undirected, so one upward graph serves both query directions.
+class ContractionHierarchy {
+private:
+    struct UpArc {
+        int to;
+        double weight;
+        int middle;   // contracted vertex this shortcut bypasses, -1 for an original road
+    };
+
+    int n = 0;
+    int shortcuts = 0;
+    std::vector<int> rank;        // contraction order, higher = more important
+    std::vector<int> upOffsets;   // CSR of arcs to higher ranked neighbors
+    std::vector<UpArc> upArcs;
+    std::vector<bool> valid;      // attraction ids known to the source graph
+
+    bool stalled(const std::vector<double>& dist, int u, double d) const;
+    // settled (vertex, distance) pairs of a full upward search from s
+    void upwardSearch(int s, std::vector<std::pair<int, double>>& settled) const;
+    // bidirectional upward query; fills the unpacked path when asked
+    double query(int s, int t, std::vector<int>* path) const;
+    const UpArc* findArc(int a, int b) const;
+    void unpack(int a, int b, std::vector<int>& out) const;
+
+public:
+    ContractionHierarchy() = default;
+
+    void build(const Graph& g);
+    bool isBuilt() const { return n > 0; }
+
+    int numShortcuts() const { return shortcuts; }
+
+    // shortest time s->t, infinity if unreachable
+    double distance(int s, int t) const;
+    // {time, full vertex path s..t with every shortcut unpacked}; empty path if unreachable
+    std::pair<double, std::vector<int>> shortestPath(int s, int t) const;
+    // bucket-based many-to-many table, one upward search per location
+    DistanceMatrix distanceMatrix(const std::vector<int>& locs) const;
+};
+
+#endif // CONTRACTION_HIERARCHY_H
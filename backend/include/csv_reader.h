@@ -0,0 +1,53 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Streaming reader for the loaders' CSV files. The file is read in large
+// blocks and each line split in place: fields are views into the block, so
+// a row costs no allocations. Lines are plain delimiter-separated values
+// (no quoting); a trailing '\r' is dropped and blank lines are skipped.
+// With ' ' as the delimiter any run of spaces and tabs separates fields,
+// for whitespace formats such as DIMACS and edge lists.
+class CsvReader {
+private:
+    std::FILE* file = nullptr;
+    std::vector<char> buffer;
+    size_t begin = 0, end = 0;          // unread bytes are buffer[begin, end)
+    bool eof = false;
+    int line = 0;
+    char delimiter;
+    std::vector<std::string_view> fields;
+
+    bool refill();
+
+public:
+    explicit CsvReader(char delimiter = ',');
+    ~CsvReader();
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+
+    bool open(const std::string& path);
+
+    // newline count of the file, an upper bound on its rows for reserving
+    // containers ahead of a load; -1 if it cannot be read
+    static long long countLines(const std::string& path);
+
+    // advance to the next non-blank line; false at end of file. The views
+    // from field() stay valid until the next call.
+    bool next();
+    int lineNumber() const { return line; }
+    int fieldCount() const { return (int)fields.size(); }
+    std::string_view field(int i) const { return i < (int)fields.size() ? fields[i] : std::string_view(); }
+
+    // Parse field i (surrounding spaces allowed). An empty or missing field
+    // leaves `out` untouched and counts as fine; false if the text is not
+    // entirely a number.
+    bool number(int i, double& out) const;
+    bool number(int i, int& out) const;
+};
+
+#endif // CSV_READER_H
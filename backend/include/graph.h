@@ -5,12 +5,59 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 
 #include "attraction.h"
 #include "../include/dsu.h"
 
 
 struct Edge; 
+struct SnapshotNode;
+
+// Frozen compressed sparse row adjacency. Neighbors of u are
+// targets[offsets[u] .. offsets[u+1]) with matching weights,
+// vertex ids index the arrays directly (0 .. numNodes-1).
+struct CSRView {
+    const int* offsets = nullptr;
+    const int* targets = nullptr;
+    const double* weights = nullptr;
+    int numNodes = 0;
+};
+
+struct Neighbor {
+    int id;
+    double weight;
+};
+
+// Non-owning view over one CSR row, so neighbor scans never copy or allocate.
+// Only valid while the Graph is alive and not modified.
+class NeighborRange {
+private:
+    const int* targets;
+    const double* weights;
+    int count;
+public:
+    class iterator {
+    private:
+        const int* t;
+        const double* w;
+    public:
+        iterator(const int* t, const double* w) : t(t), w(w) {}
+        Neighbor operator*() const { return {*t, *w}; }
+        iterator& operator++() { ++t; ++w; return *this; }
+        bool operator!=(const iterator& o) const { return t != o.t; }
+        bool operator==(const iterator& o) const { return t == o.t; }
+    };
+
+    NeighborRange() : targets(nullptr), weights(nullptr), count(0) {}
+    NeighborRange(const int* t, const double* w, int n) : targets(t), weights(w), count(n) {}
+
+    iterator begin() const { return iterator(targets, weights); }
+    iterator end() const { return iterator(targets + count, weights + count); }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    Neighbor operator[](int i) const { return {targets[i], weights[i]}; }
+};
 
 class Graph {
 private:
@@ -18,16 +65,56 @@ private:
     std::unordered_map<int, std::vector<std::pair<int, double>>> adjList;
     std::map<std::string, int> nameToId;
     int numVertices;
+    int maxId;      // largest id seen by addAttraction/addEdge, kept up to date as they run
     DSU* dsu;
+
+    // adjList is only the staging area for addEdge; searches run on these
+    std::vector<int> csrOffsets;
+    std::vector<int> csrTargets;
+    std::vector<double> csrWeights;
+
+    // Set while the graph runs off a loaded snapshot: the CSR arrays and the
+    // name index are read in place from the mapping. Any mutation copies
+    // them into the containers above first (detachSnapshot).
+    const char* snapBase = nullptr;
+    size_t snapBytes = 0;
+    bool snapMapped = false;            // mmap'd, else a heap copy
+    CSRView snapCSR;
+    const SnapshotNode* snapNodes = nullptr;
+    int snapRecords = 0;                // entries in snapNodes, in id order
+    const int* snapNameIndex = nullptr;
+    const char* snapStrings = nullptr;
+    int snapNames = 0;                  // entries in snapNameIndex
+    // Attractions built from snapNodes on first getAttraction instead of at
+    // load. Map nodes never move, so handed out references stay valid; the
+    // lock covers lookups from pool threads.
+    mutable std::unordered_map<int, Attraction> snapAttractions;
+    mutable std::mutex snapLock;
+
+    const SnapshotNode* snapRecord(int id) const;
+    Attraction snapAttraction(const SnapshotNode& r) const;
+    void releaseSnapshot();
+    void detachSnapshot();
+    void clearAll();
+    bool finishImport(std::vector<Attraction>& nodes, std::vector<Edge>& arcs);
 public:
     Graph();
     ~Graph();
+    // owns the DSU through a raw pointer, so copies would double free it
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
 
     void addAttraction(const Attraction& attr);
     void addEdge(int from, int to, double weight);
 
-    std::vector<std::pair<int, double>> getNeighbors(int nodeId) const;
-    Attraction getAttraction(int id) const;
+    // Both return views into the graph: no copies on the search hot path.
+    // getNeighbors needs the CSR (empty range until buildCSR()), and
+    // getAttraction returns a shared default Attraction (id -1) for unknown ids.
+    NeighborRange getNeighbors(int nodeId) const;
+    const Attraction& getAttraction(int id) const;
+    // just the position, false for unknown ids; never builds an Attraction,
+    // so the A* heuristic stays cheap on a snapshot
+    bool getCoordinates(int id, double& latitude, double& longitude) const;
     double getEdgeWeight(int from, int to) const;
 
     int size() const { return numVertices; }
@@ -37,6 +124,37 @@ public:
     int getIdByName(const std::string& name) const;
 
     void loadFromCSV(const std::string& attractionsFile, const std::string& roadsFile);
+    // Write the graph back in loadFromCSV's schema (openingHours column only
+    // when some attraction has hours), numbers in shortest round-trip form.
+    // Needs the CSR and named attractions; logs and returns false otherwise.
+    bool saveCSV(const std::string& attractionsFile, const std::string& roadsFile) const;
+
+    // Binary snapshot (format in snapshot.h). load maps the file and uses its
+    // CSR, records and name index in place: it only validates them (one pass
+    // over records and arcs) and builds the DSU, attractions are made on first
+    // getAttraction. Both log to stderr and return false on failure (load
+    // leaves the graph empty then).
+    bool saveSnapshot(const std::string& path) const;
+    bool loadSnapshot(const std::string& path);
+    bool fromSnapshot() const { return snapBase != nullptr; }
+
+    // Importers for large benchmark graphs. Node k becomes an attraction named
+    // "v<k>" (its id in the file) carrying the file's coordinates, if any, and
+    // each node pair gets one road at its cheapest arc weight, since these
+    // formats list both directions. Both log the file and line of the first
+    // problem to stderr and return false, leaving the graph empty.
+    // DIMACS shortest-path challenge: .gr arcs "a u v w" on 1-based ids and an
+    // optional .co with "v k x y" in degrees * 1e6 ("" for no coordinates).
+    bool loadFromDIMACS(const std::string& grFile, const std::string& coFile = "");
+    // Whitespace-separated "u v [weight]" lines, weight 1 when missing, '#'
+    // and '%' lines skipped; ids are any non-negative integers, renumbered
+    // 0..n-1 in increasing order.
+    bool loadFromEdgeList(const std::string& file);
+
+    // Freeze adjList into the CSR arrays. loadFromCSV does this itself;
+    // call it again after adding attractions/edges by hand.
+    void buildCSR();
+    CSRView csr() const;
 
     void buildDSU();
     DSU* getDSU() const { return dsu; }
@@ -46,7 +164,7 @@ public:
     bool isFullyConnected() const;
 
     std::vector<Edge> getAllEdges() const;
-    int maxNodeId() const;
+    int maxNodeId() const { return maxId; }
 };
 
 #endif // GRAPH_H
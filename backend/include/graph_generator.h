@@ -0,0 +1,33 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include <string>
+
+class Graph;
+
+// Synthetic graphs for scaling tests and the benchmarks. Each generator fills
+// a fresh (empty) Graph deterministically from its seed: ids 0..n-1 named
+// "N<id>" around 26N 73E with plausible category/rating/duration/fee/
+// popularity, then freezes the CSR and DSU. Road times are in minutes and
+// never below the straight-line distance in km, so the haversine A*
+// heuristic stays admissible. Save them with saveCSV / saveSnapshot.
+
+// rows x cols lattice ~100 m apart, 4-neighbor roads of 1-3 minutes
+void generateGrid(Graph& g, int rows, int cols, unsigned seed);
+
+// n points uniform over a square (~100 m apart on average), a road between
+// every pair closer than the radius that gives `meanDegree` neighbors on
+// average. Not necessarily connected: about n*e^-meanDegree points end up
+// isolated.
+void generateGeometric(Graph& g, int n, unsigned seed, double meanDegree = 8);
+
+// About n junctions on a jittered ~100 m lattice, planar with degree <= 4:
+// every 8th street is a fast arterial, the rest is a random spanning tree
+// plus a share of the other streets and some diagonal shortcuts. Connected.
+void generateRoadLike(Graph& g, int n, unsigned seed);
+
+// by name for tools and benches: "grid" (square-ish, about n nodes),
+// "geometric" or "road"; false for an unknown shape
+bool generateGraph(Graph& g, const std::string& shape, int n, unsigned seed);
+
+#endif // GRAPH_GENERATOR_H
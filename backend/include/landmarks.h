@@ -0,0 +1,41 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <vector>
+
+class Graph;
+
+// How LandmarkIndex::build picks its landmarks
+enum class LandmarkSelection {
+    Farthest,   // each new landmark is the vertex farthest from those chosen so far
+    Avoid       // Goldberg-Werneck "avoid": grow into regions current bounds cover badly
+};
+
+// ALT (A*, Landmarks, Triangle inequality) lower bounds.
+// For every landmark L the exact distance d(L,v) is stored; since roads are
+// undirected, |d(L,t) - d(L,v)| <= d(v,t) for any v,t, and the best landmark
+// gives an admissible, consistent A* heuristic in road-time units (minutes).
+// Distances are stored as floats rounded down, vertex-major, so a heuristic
+// evaluation reads one contiguous row of `count` floats per vertex.
+class LandmarkIndex {
+private:
+    int n = 0;
+    int k = 0;
+    std::vector<int> landmarks;
+    std::vector<float> dist;   // dist[v*k + i] = d(landmarks[i], v), +inf if unreachable
+
+public:
+    LandmarkIndex() = default;
+
+    void build(const Graph& g, int count, LandmarkSelection selection = LandmarkSelection::Avoid,
+               unsigned seed = 1);
+    bool isBuilt() const { return k > 0; }
+
+    int size() const { return k; }
+    const std::vector<int>& getLandmarks() const { return landmarks; }
+
+    // admissible lower bound on d(v,t); 0 when no landmark helps
+    double lowerBound(int v, int t) const;
+};
+
+#endif // LANDMARKS_H
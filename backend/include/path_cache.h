@@ -0,0 +1,47 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <unordered_map>
+#include <vector>
+#include "algorithms.h"
+
+class Graph;
+
+// Per-request cache of shortest-path labels keyed by source id.
+// Searches run on the thread's SearchWorkspace and stop once the requested
+// targets are settled (dijkstraToTargets). Only the targets and the vertices
+// on their paths are kept, so a source costs O(path lengths) rather than
+// O(graph size). A query for a vertex not known yet runs another early-exit
+// search for it.
+class ShortestPathCache {
+private:
+    struct Label {
+        double dist;
+        int parent;
+    };
+    // settled vertices from one source, unreachable targets at infinity
+    typedef std::unordered_map<int, Label> Tree;
+
+    const Graph& graph;
+    std::unordered_map<int, Tree> trees;
+
+    // label of `target` from `source`, null when the id is out of range
+    const Label* label(int source, int target);
+
+public:
+    explicit ShortestPathCache(const Graph& g) : graph(g) {}
+
+    // settle the `targets` not known yet from `source` with one early-exit
+    // search; no-op when all of them are
+    void prepare(int source, const std::vector<int>& targets);
+
+    // infinity when unreachable or either id is out of range
+    double distance(int source, int target);
+    // source..target inclusive, empty when unreachable
+    std::vector<int> path(int source, int target);
+    DistanceMatrix matrix(const std::vector<int>& locs);
+
+    int cachedTrees() const { return (int)trees.size(); }
+};
+
+#endif // PATH_CACHE_H
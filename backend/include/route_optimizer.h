@@ -2,26 +2,88 @@
 #define ROUTE_OPTIMIZER_H
 
 #include "graph.h"
+#include "algorithms.h"
+#include <limits>
+#include <utility>
 #include <vector>
 #include <string>
 
+class ContractionHierarchy;
+class LandmarkIndex;
+class ShortestPathCache;
+
+// Backend for fixed-order legs, path expansion and the TSP distance matrix
+enum class PathEngine {
+    Dijkstra,            // per-request shortest-path tree cache (default)
+    Bidirectional,       // bidirectional Dijkstra per leg
+    BidirectionalAStar,  // bidirectional ALT A* per leg, see setLandmarks()
+    CH                   // prebuilt ContractionHierarchy, see setContractionHierarchy()
+};
+
 struct RouteResult {
     std::vector<int> attractionIds;   // only selected stops in order
     std::vector<int> fullPath;        // FULL actual path including intermediate nodes
     double totalTime = 0.0;
     std::string algorithm;
+    double score = 0.0;               // orienteering only: collected rating * popularity / 100
+    double totalFee = 0.0;            // orienteering only: sum of entry fees
+    std::vector<double> visitStarts;  // time windows only: minutes after midnight per stop
 };
 
 class RouteOptimizer {
 private:
-    Graph graph;
+    // Borrowed, not copied: the daemon keeps one Graph alive for its whole
+    // lifetime and every request reuses it.
+    const Graph* graphPtr = nullptr;
+    PathEngine engine = PathEngine::Dijkstra;
+    const ContractionHierarchy* ch = nullptr;
+    const LandmarkIndex* landmarks = nullptr;
+    int timeBudgetMs = 0;
+    double startTime = -1;
+    MultiStartOptions multiStart{0, 1};   // starts == 0: off
+
+    bool usingCH() const { return engine == PathEngine::CH && ch != nullptr; }
+    // {time, full path u..v} on the selected engine; infinite time if unreachable
+    std::pair<double, std::vector<int>> leg(int u, int v, ShortestPathCache& cache) const;
+    DistanceMatrix stopMatrix(const std::vector<int>& locs, ShortestPathCache& cache) const;
+    std::string engineSuffix() const;
 
 public:
     RouteOptimizer() = default;
-    void setGraph(const Graph& g) { graph = g; }
+    void setGraph(const Graph& g) { graphPtr = &g; }
+    void setPathEngine(PathEngine e) { engine = e; }
+    // borrowed like the graph; CH without a hierarchy falls back to Dijkstra
+    void setContractionHierarchy(const ContractionHierarchy* h) { ch = h; }
+    // when set, the full-graph traversal runs A* with ALT bounds instead of haversine;
+    // BidirectionalAStar needs them too (falls back to Bidirectional without)
+    void setLandmarks(const LandmarkIndex* l) { landmarks = l; }
+    // > 0: flexible order runs the anytime TSP solver against this wall-clock
+    // budget and names the winning stage in RouteResult::algorithm; only then
+    // is Held-Karp tried past FLEXIBLE_EXACT_MAX, up to the table limit.
+    // 0 (default) always solves to the usual exact/LK result
+    void setTimeBudget(int ms) { timeBudgetMs = ms; }
+    // >= 0 (minutes after midnight): flexible order respects every stop's
+    // openingHours and visitDuration, starting the day at this time; totalTime
+    // is then the elapsed time until the last visit ends, waits included, and
+    // the route is empty if no order fits the opening hours
+    void setStartTime(double minutes) { startTime = minutes; }
+    // > 0: flexible order beyond FLEXIBLE_EXACT_MAX stops runs tspMultiStart
+    // with this many starts instead of Lin-Kernighan; the same seed always
+    // gives the same route. A start time or time budget takes precedence
+    void setMultiStart(int starts, unsigned seed) { multiStart = {starts, seed}; }
 
     RouteResult computeOptimalRoute(const std::vector<int>& locations, bool flexibleOrder);
     RouteResult computeFullGraphRoute();
+    // Orienteering from start over candidates (all attractions when empty):
+    // totalTime counts travel plus every visitDuration on the route. Empty
+    // result if the start alone does not fit the budgets
+    RouteResult computeOrienteeringRoute(int start, const std::vector<int>& candidates,
+                                         double timeBudget,
+                                         double feeBudget = std::numeric_limits<double>::infinity());
+    // locs[0] is where every day starts; the rest are split over `days` day
+    // routes. totalTime per day counts travel plus visitDuration of its stops
+    std::vector<RouteResult> computeMultiDayRoutes(const std::vector<int>& locs, int days,
+                                                   double dayLimit = std::numeric_limits<double>::infinity());
 };
 
 #endif // ROUTE_OPTIMIZER_H
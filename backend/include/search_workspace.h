@@ -0,0 +1,61 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Reusable buffers for one graph search (labels, settled/target marks, heap).
+// Every slot carries the generation it was written in; reset() just bumps
+// the generation, so starting a search is O(1) instead of refilling O(n)
+// arrays. Buffers only ever grow, so one workspace serves graphs of any size.
+// Not thread safe: use forThread() to get the calling thread's own instance.
+class SearchWorkspace {
+private:
+    std::vector<double> distLabel;
+    std::vector<int> parentLabel;
+    std::vector<uint32_t> labelGen;     // distLabel/parentLabel valid when == generation
+    std::vector<uint32_t> settledGen;
+    std::vector<uint32_t> markGen;
+    std::vector<std::pair<double, int>> heap;   // min-heap on the key
+    uint32_t generation = 0;
+
+public:
+    SearchWorkspace() = default;
+
+    // start a new search over vertex ids 0 .. n-1
+    void reset(int n);
+
+    double dist(int v) const {
+        return labelGen[v] == generation ? distLabel[v] : std::numeric_limits<double>::infinity();
+    }
+    int parent(int v) const { return labelGen[v] == generation ? parentLabel[v] : -1; }
+    bool reached(int v) const { return labelGen[v] == generation; }
+    void setLabel(int v, double d, int p) {
+        distLabel[v] = d;
+        parentLabel[v] = p;
+        labelGen[v] = generation;
+    }
+
+    bool settled(int v) const { return settledGen[v] == generation; }
+    void settle(int v) { settledGen[v] = generation; }
+
+    // free-form per-search flag, e.g. "v is still a pending target"
+    bool marked(int v) const { return markGen[v] == generation; }
+    void mark(int v) { markGen[v] = generation; }
+    void unmark(int v) { markGen[v] = generation - 1; }
+
+    bool heapEmpty() const { return heap.empty(); }
+    double topKey() const { return heap.front().first; }
+    void push(double key, int v);
+    std::pair<double, int> pop();
+
+    // start..target following parent labels, empty if target was not reached from start
+    std::vector<int> path(int start, int target) const;
+
+    // per-thread instances; bidirectional searches use slots 0 and 1
+    static SearchWorkspace& forThread(int slot = 0);
+};
+
+#endif // SEARCH_WORKSPACE_H
@@ -0,0 +1,57 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+
+// Binary graph snapshot, written by Graph::saveSnapshot (tools/make_snapshot
+// turns the CSVs into one) and mapped by Graph::loadSnapshot.
+//
+// Native byte order, every section 8-byte aligned, offsets from file start:
+//   SnapshotHeader
+//   int32_t  offsets[numNodes + 1]   CSR row starts, exactly Graph's layout
+//   int32_t  targets[numArcs]
+//   double   weights[numArcs]
+//   SnapshotNode nodes[numRecords]   one per attraction
+//   int32_t  nameIndex[numNames]     indices into nodes, sorted by name, for getIdByName
+//   char     strings[stringBytes]    names, categories, opening hours
+//
+// The CSR arrays are used in place, straight from the mapping; nothing in the
+// file is text. Bump SNAPSHOT_VERSION on any layout change: loaders reject
+// other versions and byte orders instead of guessing.
+const char SNAPSHOT_MAGIC[8] = {'R', 'O', 'U', 'T', 'E', 'G', 'R', 'F'};
+const uint32_t SNAPSHOT_VERSION = 1;
+const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t numNodes;       // CSR rows (max id + 1)
+    int32_t numRecords;     // attractions
+    int32_t numNames;       // distinct names (unnamed attractions are not indexed)
+    int32_t reserved;
+    int64_t numArcs;        // directed CSR entries, two per road
+    uint64_t offsetsAt, targetsAt, weightsAt, nodesAt, nameIndexAt, stringsAt;
+    uint64_t stringBytes;
+    uint64_t fileBytes;
+};
+
+// a string in the strings section
+struct SnapshotString {
+    uint32_t at;
+    uint32_t length;
+};
+
+struct SnapshotNode {
+    int32_t id;
+    int32_t popularity;
+    double latitude, longitude;
+    double visitDuration, rating, entryFee;
+    SnapshotString name, category, openingHours;
+};
+
+// the layout is the format: no implicit padding anywhere
+static_assert(sizeof(SnapshotHeader) == 104, "SnapshotHeader layout changed");
+static_assert(sizeof(SnapshotNode) == 72, "SnapshotNode layout changed");
+
+#endif // SNAPSHOT_H
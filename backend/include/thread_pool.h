@@ -0,0 +1,46 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops.
+// parallelFor(count, fn) runs fn(0) .. fn(count-1), handing out indices
+// dynamically to the workers and the calling thread, and returns once all of
+// them finished. Calls are serialized; fn must not call back into the pool.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::mutex submit;                  // one parallelFor at a time
+    std::condition_variable wake;
+    std::condition_variable finished;
+    const std::function<void(int)>* job = nullptr;
+    int jobCount = 0;
+    std::atomic<int> next{0};
+    int busy = 0;                       // workers still inside the current job
+    unsigned long long jobId = 0;
+    bool stopping = false;
+
+    void runJob();
+    void workerLoop();
+
+public:
+    // threads <= 0 means one per hardware thread; the caller counts as one
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+    // process-wide pool sized to the hardware
+    static ThreadPool& shared();
+};
+
+#endif // THREAD_POOL_H
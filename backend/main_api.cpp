@@ -1,128 +1,337 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <string>
 #include <vector>
 #include "include/json.hpp"
 #include "include/graph.h"
 #include "include/api.h"
+#include "include/contraction_hierarchy.h"
+#include "include/landmarks.h"
 
 using json = nlohmann::json;
 using namespace std;
 
-int main() {
-    try {
-        // Read complete JSON input from stdin
-        string input;
-        string line;
-        while (getline(cin, line)) {
-            input += line;
+// upper bound on a request's "multiStart": each start keeps a tour in memory
+static const int MAX_MULTI_STARTS = 256;
+
+static json errorJson(const string& message) {
+    json err;
+    err["success"] = false;
+    err["error"] = message;
+    return err;
+}
+
+static json resultToJson(const ApiResult& result) {
+    json out;
+    out["success"] = true;
+    out["algorithm"] = result.algorithm;
+    out["totalTime"] = result.totalTime;
+    out["routeIds"] = result.routeIds;
+    out["routeNames"] = result.routeNames;
+    out["stopCount"] = result.stopCount;
+    out["fullPath"] = result.fullPath;
+    out["fullPathNames"] = result.fullPathNames;
+    return out;
+}
+
+// ---------------------------------------------------------
+// Routing indexes kept for the lifetime of the process (i.e.
+// shared by every daemon request). The daemon builds them before
+// it reports ready, so no request pays for a build inside its
+// timeout; a one-shot run builds them on first use.
+// ---------------------------------------------------------
+struct EngineState {
+    unique_ptr<ContractionHierarchy> ch;
+    unique_ptr<LandmarkIndex> landmarks;
+    int landmarkCount = 8;   // --landmarks N, 0 keeps the haversine A*
+    bool buildOnDemand = true;
+};
+
+static const LandmarkIndex* landmarksFor(const Graph& graph, EngineState& state) {
+    if (state.landmarkCount <= 0) return nullptr;
+    if (!state.landmarks) {
+        state.landmarks.reset(new LandmarkIndex());
+        state.landmarks->build(graph, state.landmarkCount);
+    }
+    return state.landmarks.get();
+}
+
+// Optional "engine" field: "dijkstra" (default), "bidijkstra", "bidastar" or "ch"
+// ("ch" in daemon mode only with --ch)
+static bool parseEngine(const json& j, const Graph& graph, EngineState& state,
+                        RoutingOptions& options, string& error) {
+    string engine = j.value("engine", string("dijkstra"));
+    if (engine == "dijkstra") {
+        options.engine = PathEngine::Dijkstra;
+        return true;
+    }
+    if (engine == "bidijkstra") {
+        options.engine = PathEngine::Bidirectional;
+        return true;
+    }
+    if (engine == "bidastar") {
+        options.engine = PathEngine::BidirectionalAStar;
+        options.landmarks = landmarksFor(graph, state);
+        return true;
+    }
+    if (engine == "ch") {
+        if (!state.ch && !state.buildOnDemand) {
+            error = "The ch engine needs the optimizer started with --ch";
+            return false;
+        }
+        if (!state.ch) {
+            state.ch.reset(new ContractionHierarchy());
+            state.ch->build(graph);
         }
+        options.engine = PathEngine::CH;
+        options.ch = state.ch.get();
+        return true;
+    }
+    error = "Unknown engine: " + engine + " (expected dijkstra, bidijkstra, bidastar or ch)";
+    return false;
+}
 
-        // Parse JSON with error handling
-        json j;
-        try {
-            j = json::parse(input);
-        } catch (const json::parse_error& e) {
-            json err;
-            err["success"] = false;
-            err["error"] = string("JSON parse error: ") + e.what();
-            cout << err.dump() << endl;
-            cout.flush();
-            return 1;
+// ---------------------------------------------------------
+// Handle one request against an already loaded graph.
+// Shared by the one-shot mode and the --serve daemon.
+// ---------------------------------------------------------
+static json handleRequest(const json& j, Graph& graph, EngineState& state) {
+    // Validate required fields
+    if (!j.contains("choice") || !j.contains("count") || !j.contains("locations")) {
+        return errorJson("Missing required fields: choice, count, or locations");
+    }
+
+    int choice = j["choice"];
+    vector<string> names = j["locations"];
+
+    // ------------------------------------------
+    // Choice 4: Exit
+    // ------------------------------------------
+    if (choice == 4) {
+        json out;
+        out["success"] = true;
+        out["message"] = "Exiting Route Optimizer";
+        return out;
+    }
+
+    // ------------------------------------------
+    // Choice 3: Full campus traversal (MST + DFS + A*)
+    // ------------------------------------------
+    if (choice == 3) {
+        RoutingOptions options;
+        options.landmarks = landmarksFor(graph, state);
+        ApiResult result = runFullGraphTraversal(graph, options);
+        if (!result.success) {
+            json out = errorJson(result.errorMessage);
+            out["algorithm"] = "Kruskal (MST) + DFS Traversal + A* Path Refinement";
+            return out;
         }
+        return resultToJson(result);
+    }
 
-        // Validate required fields
-        if (!j.contains("choice") || !j.contains("count") || !j.contains("locations")) {
-            json err;
-            err["success"] = false;
-            err["error"] = "Missing required fields: choice, count, or locations";
-            cout << err.dump() << endl;
-            cout.flush();
-            return 1;
+    // ------------------------------------------
+    // Choice 5: Orienteering within a time budget
+    // locations[0] is the start, any others limit the candidates;
+    // "timeBudget" (minutes) is required, "feeBudget" optional
+    // ------------------------------------------
+    if (choice == 5) {
+        if (names.empty()) return errorJson("Orienteering needs a start location");
+        if (!j.contains("timeBudget") || !j["timeBudget"].is_number())
+            return errorJson("Orienteering needs a numeric timeBudget (minutes)");
+        double timeBudget = j["timeBudget"];
+        double feeBudget = j.value("feeBudget", numeric_limits<double>::infinity());
+
+        RoutingOptions options;
+        string engineError;
+        if (!parseEngine(j, graph, state, options, engineError)) return errorJson(engineError);
+
+        vector<string> candidates(names.begin() + 1, names.end());
+        ApiResult result = runOrienteeringAPI(names[0], candidates, timeBudget, feeBudget, graph, options);
+        if (!result.success) return errorJson(result.errorMessage);
+        json out = resultToJson(result);
+        out["score"] = result.score;
+        out["totalFee"] = result.totalFee;
+        return out;
+    }
+
+    // ------------------------------------------
+    // Choice 6: Multi-day itinerary
+    // locations[0] starts every day; "days" (k >= 1) is required,
+    // "dayLimit" (minutes per day) optional. More days than stops would
+    // only stay empty, so k is capped at the number of stops.
+    // ------------------------------------------
+    if (choice == 6) {
+        if (!j.contains("days") || !j["days"].is_number_integer() || j["days"].get<long long>() < 1)
+            return errorJson("Multi-day planning needs an integer days >= 1");
+        long long stops = max<long long>((long long)names.size() - 1, 1);
+        int days = (int)min(j["days"].get<long long>(), stops);
+        double dayLimit = j.value("dayLimit", numeric_limits<double>::infinity());
+
+        RoutingOptions options;
+        string engineError;
+        if (!parseEngine(j, graph, state, options, engineError)) return errorJson(engineError);
+
+        MultiDayResult result = runMultiDayAPI(names, days, dayLimit, graph, options);
+        if (!result.success) return errorJson(result.errorMessage);
+        json out;
+        out["success"] = true;
+        out["algorithm"] = result.days.empty() ? string() : result.days[0].algorithm;
+        double total = 0, longest = 0;
+        out["days"] = json::array();
+        for (const ApiResult& day : result.days) {
+            out["days"].push_back(resultToJson(day));
+            total += day.totalTime;
+            longest = max(longest, day.totalTime);
+        }
+        out["totalTime"] = total;
+        out["longestDay"] = longest;
+        return out;
+    }
+
+    // ------------------------------------------
+    // Choices 1 & 2: TSP or Dijkstra
+    // ------------------------------------------
+    RoutingOptions options;
+    string engineError;
+    if (!parseEngine(j, graph, state, options, engineError)) return errorJson(engineError);
+    // Optional "timeBudgetMs": answer a flexible route within this many milliseconds
+    options.timeBudgetMs = j.value("timeBudgetMs", 0);
+    if (options.timeBudgetMs < 0) return errorJson("timeBudgetMs must not be negative");
+    // Optional "startTime" ("HH:MM"): plan the flexible route around opening hours
+    if (j.contains("startTime")) {
+        string start = j["startTime"].is_string() ? j["startTime"].get<string>() : string();
+        if (!parseClockTime(start, options.startTime)) return errorJson("startTime must look like HH:MM");
+    }
+    // Optional "multiStart" (number of starts) and "seed": multi-start local
+    // search for large flexible routes, reproducible for a given seed
+    if (j.contains("multiStart")) {
+        if (!j["multiStart"].is_number_integer() || j["multiStart"].get<long long>() < 0 ||
+            j["multiStart"].get<long long>() > MAX_MULTI_STARTS)
+            return errorJson("multiStart must be an integer from 0 to " + to_string(MAX_MULTI_STARTS));
+        options.multiStarts = j["multiStart"];
+    }
+    if (j.contains("seed")) {
+        if (!j["seed"].is_number_unsigned() || j["seed"].get<unsigned long long>() > UINT32_MAX)
+            return errorJson("seed must be a non-negative 32-bit integer");
+        options.multiStartSeed = j["seed"];
+    }
+
+    ApiResult result = runOptimizerAPI(choice, names, graph, options);
+    if (!result.success) return errorJson(result.errorMessage);
+    json out = resultToJson(result);
+    if (!result.visitStarts.empty()) {
+        // visit start per routeNames entry, as HH:MM (past 24:00 for overnight routes)
+        json schedule = json::array();
+        for (double t : result.visitStarts) {
+            int minutes = (int)(t + 0.5);
+            char buf[16];
+            snprintf(buf, sizeof(buf), "%02d:%02d", minutes / 60, minutes % 60);
+            schedule.push_back(buf);
+        }
+        out["schedule"] = schedule;
+    }
+    return out;
+}
+
+// ---------------------------------------------------------
+// Daemon mode: load the graph once, then answer one JSON
+// request per line on stdin with one JSON line on stdout
+// until stdin closes. server.js keeps a pool of these warm and
+// only sends requests after the {"ready":true} line.
+// ---------------------------------------------------------
+static int serve(Graph& graph, EngineState& state) {
+    cout << json{{"ready", true}}.dump() << "\n";
+    cout.flush();
+    string line;
+    while (getline(cin, line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos) continue;
+
+        json out;
+        try {
+            out = handleRequest(json::parse(line), graph, state);
+        } catch (const json::parse_error& e) {
+            out = errorJson(string("JSON parse error: ") + e.what());
+        } catch (const exception& e) {
+            out = errorJson(string("Unexpected error: ") + e.what());
         }
+        cout << out.dump() << "\n";
+        cout.flush();
+    }
+    return 0;
+}
 
-        int choice = j["choice"];
-        int count = j["count"];
-        vector<string> names = j["locations"];
+int main(int argc, char** argv) {
+    bool daemon = false;
+    bool buildCH = false;
+    EngineState state;
+    string snapshot;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--serve") daemon = true;
+        else if (arg == "--ch") buildCH = true;
+        else if (arg == "--landmarks" && i + 1 < argc) state.landmarkCount = atoi(argv[++i]);
+        else if (arg == "--snapshot" && i + 1 < argc) snapshot = argv[++i];
+    }
 
+    try {
         // Load graph
         Graph graph;
         try {
-            graph.loadFromCSV("attractions.csv", "roads.csv");
+            // a snapshot (tools/make_snapshot) is mapped instead of parsing the CSVs
+            if (snapshot.empty()) graph.loadFromCSV("attractions.csv", "roads.csv");
+            else if (!graph.loadSnapshot(snapshot)) {
+                cout << errorJson("Failed to load graph snapshot: " + snapshot).dump() << endl;
+                cout.flush();
+                return 1;
+            }
         } catch (const exception& e) {
-            json err;
-            err["success"] = false;
-            err["error"] = string("Failed to load graph data: ") + e.what();
-            cout << err.dump() << endl;
+            cout << errorJson(string("Failed to load graph data: ") + e.what()).dump() << endl;
             cout.flush();
             return 1;
         }
 
-        // ------------------------------------------
-        // Choice 4: Exit
-        // ------------------------------------------
-        if (choice == 4) {
-            json out;
-            out["success"] = true;
-            out["message"] = "Exiting Route Optimizer";
-            cout << out.dump() << endl;
-            cout.flush();
-            return 0;
+        // offline node ordering + shortcuts, before any request arrives
+        if (buildCH) {
+            state.ch.reset(new ContractionHierarchy());
+            state.ch->build(graph);
         }
-
-        // ------------------------------------------
-        // Choice 3: Full campus traversal (MST + DFS + A*)
-        // ------------------------------------------
-        if (choice == 3) {
-            ApiResult result = runFullGraphTraversal(graph);
-
-            json out;
-            if (!result.success) {
-                out["success"] = false;
-                out["error"] = result.errorMessage;
-                out["algorithm"] = "Kruskal (MST) + DFS Traversal + A* Path Refinement";
-            } else {
-                out["success"] = true;
-                out["algorithm"] = result.algorithm;
-                out["totalTime"] = result.totalTime;
-                out["routeIds"] = result.routeIds;
-                out["routeNames"] = result.routeNames;
-                out["stopCount"] = result.stopCount;
-                out["fullPath"] = result.fullPath;
-                out["fullPathNames"] = result.fullPathNames;
-            }
-            cout << out.dump() << endl;
-            cout.flush();
-            return 0;
+        if (daemon) {
+            // the ALT landmarks serve bidastar and the full traversal
+            landmarksFor(graph, state);
+            state.buildOnDemand = false;
+            return serve(graph, state);
         }
 
-        // ------------------------------------------
-        // Choices 1 & 2: TSP or Dijkstra
-        // ------------------------------------------
-        ApiResult result = runOptimizerAPI(choice, names, graph);
+        // Read complete JSON input from stdin
+        string input;
+        string line;
+        while (getline(cin, line)) {
+            input += line;
+        }
 
-        json out;
-        if (!result.success) {
-            out["success"] = false;
-            out["error"] = result.errorMessage;
-        } else {
-            out["success"] = true;
-            out["algorithm"] = result.algorithm;
-            out["totalTime"] = result.totalTime;
-            out["routeIds"] = result.routeIds;
-            out["routeNames"] = result.routeNames;
-            out["stopCount"] = result.stopCount;
-            out["fullPath"] = result.fullPath;
-            out["fullPathNames"] = result.fullPathNames;
+        // Parse JSON with error handling
+        json j;
+        try {
+            j = json::parse(input);
+        } catch (const json::parse_error& e) {
+            cout << errorJson(string("JSON parse error: ") + e.what()).dump() << endl;
+            cout.flush();
+            return 1;
         }
+
+        json out = handleRequest(j, graph, state);
         cout << out.dump() << endl;
         cout.flush();
-        return 0;
+        bool wellFormed = j.contains("choice") && j.contains("count") && j.contains("locations");
+        return wellFormed ? 0 : 1;
 
     } catch (const exception& e) {
-        json err;
-        err["success"] = false;
-        err["error"] = string("Unexpected error: ") + e.what();
-        cout << err.dump() << endl;
+        cout << errorJson(string("Unexpected error: ") + e.what()).dump() << endl;
         cout.flush();
         return 1;
     }
@@ -2,151 +2,216 @@ const express = require("express");
 const cors = require("cors");
 const { spawn } = require("child_process");
 const path = require("path");
+const fs = require("fs");
+const os = require("os");
+const readline = require("readline");
 
 const app = express();
 
 app.use(cors());
 app.use(express.json());
 
+const exePath = path.join(__dirname, "optimizer");
+const REQUEST_TIMEOUT_MS = 30000;
+const RESPAWN_DELAY_MS = 250;
+const MAX_RESPAWN_DELAY_MS = 30000;
+// workers in a row that die before reporting ready (bad snapshot, missing CSVs, ...)
+// until requests are refused as "optimizer unavailable" instead of queued
+const MAX_START_FAILURES = 5;
+const POOL_SIZE = Math.max(1, parseInt(process.env.OPTIMIZER_WORKERS, 10) || Math.min(os.cpus().length, 4));
+// Optional binary graph snapshot (see tools/make_snapshot) to map instead of the CSVs
+const SNAPSHOT = process.env.OPTIMIZER_SNAPSHOT;
+// OPTIMIZER_CH=1 builds the contraction hierarchy at worker startup, which
+// "engine": "ch" requests need
+const PREBUILD_CH = process.env.OPTIMIZER_CH === "1";
+
+// ---------------------------------------------------------
+// Warm optimizer workers
+// Each worker runs `optimizer --serve`, which loads the graph once and then
+// answers one JSON line per request line. Its first line is {"ready":true},
+// sent once the graph and routing indexes are built; only then is it given
+// requests. A worker handles one request at a time; extra requests wait in
+// `backlog` until a worker frees up.
+// ---------------------------------------------------------
+const workers = [];
+const backlog = [];
+let respawning = 0;       // retired workers whose replacement is still waiting to start
+let startFailures = 0;    // consecutive workers that died before reporting ready
+let lastFailure = "";
+
+function optimizerUnavailable() {
+    return startFailures >= MAX_START_FAILURES;
+}
+
+function rejectBacklog(reason) {
+    while (backlog.length > 0) backlog.shift().reject(new Error(reason));
+}
+
+function startWorker() {
+    const args = ["--serve"];
+    if (SNAPSHOT) args.push("--snapshot", SNAPSHOT);
+    if (PREBUILD_CH) args.push("--ch");
+    const child = spawn(exePath, args, {
+        cwd: __dirname,
+        stdio: ["pipe", "pipe", "pipe"]
+    });
+    const worker = { child, job: null, alive: true, ready: false };
+
+    readline.createInterface({ input: child.stdout }).on("line", (line) => {
+        if (!worker.ready) {
+            if (line.trim() === '{"ready":true}') {
+                worker.ready = true;
+                startFailures = 0;
+                dispatch();
+            } else {
+                console.error("C++ worker failed to start:", line);
+            }
+            return;
+        }
+        const job = worker.job;
+        if (!job) {
+            console.error("C++ worker produced unsolicited output:", line);
+            return;
+        }
+        worker.job = null;
+        clearTimeout(job.timeoutId);
+        job.resolve(line);
+        dispatch();
+    });
+
+    child.stderr.on("data", (data) => {
+        console.error("C++ stderr:", data.toString());
+    });
+
+    const retire = (reason) => {
+        if (!worker.alive) return;
+        worker.alive = false;
+        const idx = workers.indexOf(worker);
+        if (idx !== -1) workers.splice(idx, 1);
+        if (worker.job) {
+            clearTimeout(worker.job.timeoutId);
+            worker.job.reject(new Error(reason));
+            worker.job = null;
+        }
+        // keep the pool at full strength. Workers that die during startup
+        // double the delay each time, so a broken setup retries slowly instead
+        // of spinning, and past the cap requests fail fast until one starts
+        if (!worker.ready) {
+            startFailures++;
+            lastFailure = reason;
+            if (optimizerUnavailable()) rejectBacklog(unavailableMessage(reason));
+        }
+        const delay = Math.min(RESPAWN_DELAY_MS * 2 ** (worker.ready ? 0 : startFailures - 1), MAX_RESPAWN_DELAY_MS);
+        respawning++;
+        setTimeout(() => {
+            respawning--;
+            workers.push(startWorker());
+            dispatch();
+        }, delay);
+    };
+
+    worker.retire = retire;
+    child.on("error", (err) => retire(`Failed to start optimizer: ${err.message}`));
+    child.on("exit", (code) => retire(`C++ optimizer exited unexpectedly (exit code: ${code})`));
+    child.stdin.on("error", (err) => retire(`Failed to send data to optimizer: ${err.message}`));
+
+    return worker;
+}
+
+function dispatch() {
+    while (backlog.length > 0) {
+        const worker = workers.find((w) => w.alive && w.ready && !w.job);
+        if (!worker) return;
+
+        const job = backlog.shift();
+        worker.job = job;
+        job.timeoutId = setTimeout(() => {
+            console.error("ERROR: Timeout - killing C++ worker");
+            // retire before the kill so nothing is dispatched to the dying process
+            worker.retire("C++ program timeout (>30s)");
+            worker.child.kill();
+        }, REQUEST_TIMEOUT_MS);
+        worker.child.stdin.write(job.payload + "\n");
+    }
+}
+
+function unavailableMessage(reason) {
+    return `C++ optimizer unavailable: ${startFailures} workers in a row failed to start (last: ${reason})`;
+}
+
+function ensurePool() {
+    while (workers.length + respawning < POOL_SIZE) workers.push(startWorker());
+}
+
+function runOptimizer(body) {
+    return new Promise((resolve, reject) => {
+        if (optimizerUnavailable()) return reject(new Error(unavailableMessage(lastFailure)));
+        backlog.push({ payload: JSON.stringify(body), resolve, reject, timeoutId: null });
+        dispatch();
+    });
+}
+
 app.get("/", (req, res) => {
     res.send("Backend is running!");
 });
 
-app.post("/api/route", (req, res) => {
+app.post("/api/route", async (req, res) => {
     console.log("=== Received Request ===");
     console.log("Request body:", JSON.stringify(req.body, null, 2));
 
-    const exePath = path.join(__dirname, "optimizer");
-    console.log("Executable path:", exePath);
-
-    const fs = require('fs');
     if (!fs.existsSync(exePath)) {
-        console.error("ERROR: optimizer.exe not found at", exePath);
+        console.error("ERROR: optimizer not found at", exePath);
         return res.status(500).json({
             success: false,
             error: "C++ optimizer executable not found"
         });
     }
 
-    const child = spawn(exePath, [], {
-        cwd: __dirname,
-        stdio: ['pipe', 'pipe', 'pipe']
-    });
-
-
-
-    // Track if response was sent
-    let responseSent = false;
-
-    child.on('error', (err) => {
-        console.error("ERROR: Failed to spawn process:", err);
-        if (!responseSent) {
-            responseSent = true;
-            clearTimeout(timeoutId);
-            return res.status(500).json({
-                success: false,
-                error: `Failed to start optimizer: ${err.message}`
-            });
-        }
-    });
-
-    const inputData = JSON.stringify(req.body);
-    console.log("Sending to C++:", inputData);
+    ensurePool();
 
+    let output;
     try {
-        child.stdin.write(inputData);
-        child.stdin.end();
+        output = await runOptimizer(req.body);
     } catch (err) {
-        console.error("ERROR: Failed to write to stdin:", err);
-        if (!responseSent) {
-            responseSent = true;
-            clearTimeout(timeoutId);
-            return res.status(500).json({
-                success: false,
-                error: `Failed to send data to optimizer: ${err.message}`
-            });
-        }
+        console.error("ERROR:", err.message);
+        return res.status(500).json({
+            success: false,
+            error: err.message
+        });
     }
 
-    let output = "";
-    let errorOutput = "";
-
-    child.stdout.on("data", (data) => {
-        const chunk = data.toString();
-        console.log("C++ stdout:", chunk);
-        output += chunk;
-    });
-
-    child.stderr.on("data", (data) => {
-        const chunk = data.toString();
-        console.error("C++ stderr:", chunk);
-        errorOutput += chunk;
-    });
-
-    child.on("close", (code) => {
-        console.log("=== C++ Process Closed ===");
-        console.log("Exit code:", code);
-        console.log("Full stdout:", output);
-        console.log("Full stderr:", errorOutput);
-
-        // Clear timeout
-        clearTimeout(timeoutId);
-
-        // Don't send response if already sent
-        if (responseSent) {
-            console.log("Response already sent, skipping");
-            return;
-        }
-        responseSent = true;
-
-        // Check for output even if exit code is non-zero
-        if (!output.trim()) {
-            return res.status(500).json({
-                success: false,
-                error: `C++ program produced no output (exit code: ${code})`,
-                details: errorOutput
-            });
+    try {
+        const jsonData = JSON.parse(output);
+        console.log("=== Parsed JSON ===");
+        console.log(jsonData);
+
+        // Validate response structure: a route carries routeNames, a
+        // multi-day plan (choice 6) a days array of such routes
+        if (!Array.isArray(jsonData.routeNames) && !Array.isArray(jsonData.days)) {
+            throw new Error("Invalid response: missing routeNames or days array");
         }
 
-        try {
-            const jsonData = JSON.parse(output);
-            console.log("=== Parsed JSON ===");
-            console.log(jsonData);
-
-            // Validate response structure
-            if (!jsonData.routeNames || !Array.isArray(jsonData.routeNames)) {
-                throw new Error("Invalid response: missing routeNames array");
-            }
+        // Send success response
+        res.json(jsonData);
 
-            // Send success response
-            res.json(jsonData);
-
-        } catch (err) {
-            console.error("ERROR: Failed to parse JSON:", err.message);
-            return res.status(500).json({
-                success: false,
-                error: "Invalid JSON from C++ program",
-                details: err.message,
-                raw: output.substring(0, 500)
-            });
-        }
-    });
-
-    // Timeout after 30 seconds
-    const timeoutId = setTimeout(() => {
-        if (!responseSent && !child.killed) {
-            console.error("ERROR: Timeout - killing C++ process");
-            responseSent = true;
-            child.kill();
-            res.status(500).json({
-                success: false,
-                error: "C++ program timeout (>30s)"
-            });
-        }
-    }, 30000);
+    } catch (err) {
+        console.error("ERROR: Failed to parse JSON:", err.message);
+        return res.status(500).json({
+            success: false,
+            error: "Invalid JSON from C++ program",
+            details: err.message,
+            raw: output.substring(0, 500)
+        });
+    }
 });
 
+if (fs.existsSync(exePath)) {
+    ensurePool();
+} else {
+    console.error("ERROR: optimizer not found at", exePath);
+}
+
 const PORT = 5000;
 app.listen(PORT, () => {
-    console.log(`Backend is running!`);
-});
\ No newline at end of file
+    console.log(`Backend is running with ${workers.length} optimizer worker(s)!`);
+});
@@ -4,7 +4,8 @@
 ApiResult runOptimizerAPI(
     int mode, 
     const std::vector<std::string>& locations,
-    Graph& graph
+    Graph& graph,
+    const RoutingOptions& options
 ) {
     ApiResult result;
     result.success = false;
@@ -66,8 +67,22 @@ ApiResult runOptimizerAPI(
     bool flexible = (mode == 1);
     RouteOptimizer optimizer;
     optimizer.setGraph(graph);
+    optimizer.setPathEngine(options.engine);
+    optimizer.setContractionHierarchy(options.ch);
+    optimizer.setLandmarks(options.landmarks);
+    optimizer.setTimeBudget(options.timeBudgetMs);
+    optimizer.setStartTime(options.startTime);
+    optimizer.setMultiStart(options.multiStarts, options.multiStartSeed);
 
     RouteResult r = optimizer.computeOptimalRoute(ids, flexible);
+    if (r.attractionIds.empty()) {
+        // only the time-window solver can reject every order
+        if (flexible && options.startTime >= 0)
+            result.errorMessage = "No visiting order fits the opening hours of the selected locations";
+        else
+            result.errorMessage = "No route could be computed for the selected locations";
+        return result;
+    }
 
     // Build result
     result.success = true;
@@ -75,6 +90,7 @@ ApiResult runOptimizerAPI(
     result.totalTime = r.totalTime;
     result.routeIds = r.attractionIds;
     result.stopCount = r.attractionIds.size();
+    result.visitStarts = r.visitStarts;
 
     // Build route names for requested stops
     for (int id : r.attractionIds) {
@@ -90,7 +106,7 @@ ApiResult runOptimizerAPI(
     return result;
 }
 
-ApiResult runFullGraphTraversal(Graph& graph) {
+ApiResult runFullGraphTraversal(Graph& graph, const RoutingOptions& options) {
     ApiResult result;
     result.success = false;
     result.totalTime = 0.0;
@@ -98,6 +114,7 @@ ApiResult runFullGraphTraversal(Graph& graph) {
 
     RouteOptimizer optimizer;
     optimizer.setGraph(graph);
+    optimizer.setLandmarks(options.landmarks);
 
     RouteResult r = optimizer.computeFullGraphRoute();
 
@@ -126,3 +143,132 @@ ApiResult runFullGraphTraversal(Graph& graph) {
 
     return result;
 }
+
+ApiResult runOrienteeringAPI(
+    const std::string& start,
+    const std::vector<std::string>& candidates,
+    double timeBudget,
+    double feeBudget,
+    Graph& graph,
+    const RoutingOptions& options
+) {
+    ApiResult result;
+    result.success = false;
+    result.totalTime = 0.0;
+    result.stopCount = 0;
+
+    int startId = graph.getIdByName(start);
+    if (startId == -1) {
+        result.errorMessage = "Start location does not exist: " + start;
+        return result;
+    }
+
+    std::vector<int> ids;
+    std::vector<std::string> invalidNames;
+    for (const auto& name : candidates) {
+        int id = graph.getIdByName(name);
+        if (id == -1) invalidNames.push_back(name);
+        else ids.push_back(id);
+    }
+    if (!invalidNames.empty()) {
+        result.errorMessage = "One or more location names do not exist: ";
+        for (size_t i = 0; i < invalidNames.size(); ++i) {
+            result.errorMessage += invalidNames[i];
+            if (i < invalidNames.size() - 1) result.errorMessage += ", ";
+        }
+        return result;
+    }
+
+    RouteOptimizer optimizer;
+    optimizer.setGraph(graph);
+    optimizer.setPathEngine(options.engine);
+    optimizer.setContractionHierarchy(options.ch);
+    optimizer.setLandmarks(options.landmarks);
+
+    RouteResult r = optimizer.computeOrienteeringRoute(startId, ids, timeBudget, feeBudget);
+    if (r.attractionIds.empty()) {
+        result.errorMessage = "Budget too small: visiting " + start + " alone exceeds it";
+        return result;
+    }
+
+    result.success = true;
+    result.algorithm = r.algorithm;
+    result.totalTime = r.totalTime;
+    result.score = r.score;
+    result.totalFee = r.totalFee;
+    result.routeIds = r.attractionIds;
+    result.stopCount = r.attractionIds.size();
+
+    for (int id : r.attractionIds) {
+        result.routeNames.push_back(graph.getAttraction(id).name);
+    }
+
+    result.fullPath = r.fullPath;
+    for (int id : r.fullPath) {
+        result.fullPathNames.push_back(graph.getAttraction(id).name);
+    }
+
+    return result;
+}
+
+MultiDayResult runMultiDayAPI(
+    const std::vector<std::string>& locations,
+    int days,
+    double dayLimit,
+    Graph& graph,
+    const RoutingOptions& options
+) {
+    MultiDayResult result;
+
+    std::vector<int> ids;
+    std::vector<std::string> invalidNames;
+    for (const auto& name : locations) {
+        int id = graph.getIdByName(name);
+        if (id == -1) invalidNames.push_back(name);
+        ids.push_back(id);
+    }
+    if (ids.empty()) {
+        result.errorMessage = "No locations selected";
+        return result;
+    }
+    if (!invalidNames.empty()) {
+        result.errorMessage = "One or more location names do not exist: ";
+        for (size_t i = 0; i < invalidNames.size(); ++i) {
+            result.errorMessage += invalidNames[i];
+            if (i < invalidNames.size() - 1) result.errorMessage += ", ";
+        }
+        return result;
+    }
+
+    DSU* dsu = graph.getDSU();
+    if (dsu != nullptr) {
+        int root = dsu->find(ids[0]);
+        for (int id : ids) {
+            if (dsu->find(id) != root) {
+                result.errorMessage = "Selected locations are not reachable from each other (DSU connectivity check failed)";
+                return result;
+            }
+        }
+    }
+
+    RouteOptimizer optimizer;
+    optimizer.setGraph(graph);
+    optimizer.setPathEngine(options.engine);
+    optimizer.setContractionHierarchy(options.ch);
+    optimizer.setLandmarks(options.landmarks);
+
+    for (const RouteResult& r : optimizer.computeMultiDayRoutes(ids, days, dayLimit)) {
+        ApiResult day;
+        day.success = true;
+        day.algorithm = r.algorithm;
+        day.totalTime = r.totalTime;
+        day.routeIds = r.attractionIds;
+        day.stopCount = r.attractionIds.size();
+        for (int id : r.attractionIds) day.routeNames.push_back(graph.getAttraction(id).name);
+        day.fullPath = r.fullPath;
+        for (int id : r.fullPath) day.fullPathNames.push_back(graph.getAttraction(id).name);
+        result.days.push_back(day);
+    }
+    result.success = true;
+    return result;
+}
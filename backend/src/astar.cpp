@@ -1,9 +1,8 @@
 #include "../include/algorithms.h"
 #include "../include/graph.h"
+#include "../include/landmarks.h"
+#include "../include/search_workspace.h"
 #include <algorithm>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
 #include <cmath>
 #include <vector>
 #ifndef M_PI
@@ -20,61 +19,62 @@ double haversine(double lat1,double lon1,double lat2,double lon2) {
     double c=2.0*atan2(sqrt(a),sqrt(1.0-a));
     return R*c*1000.0; // meters
 }
-struct AStarNode { int id; double f; };
-struct AStarCompare { bool operator()(const AStarNode& a,const AStarNode& b) const { return a.f > b.f; } };
-vector<int> aStarPath(const Graph& g,int start,int goal) {
+// Shared A* loop; `heuristic(v)` estimates the remaining time from v to goal.
+// g-scores and parents live in the workspace labels, the closed set is its settled marks.
+template <typename Heuristic>
+static vector<int> aStarSearch(const Graph& g,int start,int goal,Heuristic heuristic,SearchWorkspace& ws,int* settled) {
+    int n=g.csr().numNodes;
+    ws.reset(n);
+    if (settled) *settled=0;
+    if (start<0 || goal<0 || start>=n || goal>=n) return {};
+    ws.setLabel(start,0.0,-1);
+    ws.push(heuristic(start),start);
+
+    while (!ws.heapEmpty()) {
+        int u=ws.pop().second;
+        if (u==goal) return ws.path(start,goal); // walk parents back from the goal
+        if (ws.settled(u)) continue;
+        ws.settle(u);
+        if (settled) ++*settled;
+        double gu=ws.dist(u);
+        for (Neighbor nb:g.getNeighbors(u)) {
+            int v=nb.id;
+            if (ws.settled(v)) continue;
+            double tentative=gu+nb.weight;
+            if (tentative<ws.dist(v)) {
+                ws.setLabel(v,tentative,u);
+                ws.push(tentative+heuristic(v),v);
+            }
+        }
+    }
+    return {};
+}
+vector<int> aStarPath(const Graph& g,int start,int goal,SearchWorkspace& ws,int* settled) {
     // Basic A* — returns empty vector if heuristic or nodes not present or no path
     if (!g.isValidAttraction(start) || !g.isValidAttraction(goal)) return {};
-        Attraction sa=g.getAttraction(start);
-        Attraction ga=g.getAttraction(goal);
-    if (sa.latitude==0 && sa.longitude==0) return {};
-    if (ga.latitude==0 && ga.longitude==0) return {};
+    double sLat,sLon,gLat,gLon;
+    g.getCoordinates(start,sLat,sLon);
+    g.getCoordinates(goal,gLat,gLon);
+    if (sLat==0 && sLon==0) return {};
+    if (gLat==0 && gLon==0) return {};
 // Heuristic: estimate distance from current node to goal using harversine(calculatres geogrpahic distance on earth with lat,long)
 
-    unordered_map<int,double> gscore;
-    unordered_map<int,double> fscore;
-    unordered_map<int,int> cameFrom;
-    unordered_set<int> closed;
-
     auto heuristic=[&](int node) {//the heuristic function(A* is dijkstra with heuristic)
-        Attraction a=g.getAttraction(node);
-        return haversine(a.latitude,a.longitude,ga.latitude,ga.longitude)/1000.0;
+        double lat=0,lon=0;
+        g.getCoordinates(node,lat,lon);
+        return haversine(lat,lon,gLat,gLon)/1000.0;
     };
-    priority_queue<AStarNode,vector<AStarNode>,AStarCompare> pq;
-    gscore[start]=0.0;
-    fscore[start]=heuristic(start);
-    pq.push({start,fscore[start]});
-
-    while (!pq.empty()) {
-        AStarNode cur=pq.top(); pq.pop();
-        int u=cur.id;
-        if (u==goal) {
-            vector<int> path;
-            int x=goal;
-            while (cameFrom.find(x)!=cameFrom.end()) {
-                path.push_back(x);
-                x=cameFrom[x];
-                }
-            path.push_back(start);
-            reverse(path.begin(),path.end());// Reconstruct the final path by walking backward from the goal to the start
-
-            return path;
-        }
-        if (closed.count(u)) continue;
-        closed.insert(u);
-        auto nbrs=g.getNeighbors(u);
-        for (size_t i=0; i<nbrs.size(); ++i) {
-            int v=nbrs[i].first;
-            double w=nbrs[i].second;
-            if (closed.count(v)) continue;
-            double tentative=gscore[u]+w;
-            if (gscore.find(v)==gscore.end() || tentative<gscore[v]) {
-                cameFrom[v]=u;
-                gscore[v]=tentative;
-                fscore[v]=tentative+heuristic(v);
-                pq.push({v,fscore[v]});
-            }
-        }
-    }
-    return {};
+    return aStarSearch(g,start,goal,heuristic,ws,settled);
+}
+vector<int> aStarPath(const Graph& g,int start,int goal,const LandmarkIndex& landmarks,SearchWorkspace& ws,int* settled) {
+    // ALT: landmark bounds are in road-time units and need no coordinates
+    if (!g.isValidAttraction(start) || !g.isValidAttraction(goal)) return {};
+    auto heuristic=[&](int node) { return landmarks.lowerBound(node,goal); };
+    return aStarSearch(g,start,goal,heuristic,ws,settled);
+}
+vector<int> aStarPath(const Graph& g,int start,int goal,int* settled) {
+    return aStarPath(g,start,goal,SearchWorkspace::forThread(),settled);
+}
+vector<int> aStarPath(const Graph& g,int start,int goal,const LandmarkIndex& landmarks,int* settled) {
+    return aStarPath(g,start,goal,landmarks,SearchWorkspace::forThread(),settled);
 }
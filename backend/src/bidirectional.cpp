@@ -0,0 +1,77 @@
+#include "../include/algorithms.h"
+#include "../include/graph.h"
+#include "../include/landmarks.h"
+#include "../include/search_workspace.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+using namespace std;
+// Bidirectional search from start and goal at once.
+// `potential(v)` turns it into bidirectional A*: the forward side orders by
+// d_f(v)+p(v), the backward side by d_b(v)-p(v). With p = (pi_goal - pi_start)/2
+// (average of two consistent potentials) both reduced graphs coincide, so the
+// usual stopping rule top_f + top_b >= best stays exact. p = 0 is plain
+// bidirectional Dijkstra. Roads are undirected, so both sides walk the same CSR.
+template <typename Potential>
+static pair<double,vector<int>> bidirectionalSearch(const Graph& g,int start,int goal,
+                                                    Potential potential,SearchWorkspace& fwd,
+                                                    SearchWorkspace& bwd,int* settled) {
+    const double INF=numeric_limits<double>::infinity();
+    if (settled) *settled=0;
+    int n=g.csr().numNodes;
+    if (start<0 || goal<0 || start>=n || goal>=n) return {INF,{}};
+    if (!g.isValidAttraction(start) || !g.isValidAttraction(goal)) return {INF,{}};
+    if (start==goal) return {0,{start}};
+    // side 0 searches from start, side 1 from goal; sign flips the potential
+    SearchWorkspace* ws[2]={&fwd,&bwd};
+    const double sign[2]={1.0,-1.0};
+    fwd.reset(n); fwd.setLabel(start,0,-1); fwd.push(potential(start),start);
+    bwd.reset(n); bwd.setLabel(goal,0,-1); bwd.push(-potential(goal),goal);
+    double best=INF; int meet=-1;
+    while (!fwd.heapEmpty() && !bwd.heapEmpty()) {
+        if (fwd.topKey()+bwd.topKey()>=best) break;
+        int side=fwd.topKey()<=bwd.topKey() ? 0 : 1;
+        SearchWorkspace& me=*ws[side];
+        SearchWorkspace& other=*ws[1-side];
+        int u=me.pop().second;
+        if (me.settled(u)) continue;
+        me.settle(u);
+        if (settled) ++*settled;
+        double du=me.dist(u);
+        for (Neighbor nb:g.getNeighbors(u)) {
+            int v=nb.id;
+            double nd=du+nb.weight;
+            if (nd<me.dist(v)) {
+                me.setLabel(v,nd,u);
+                me.push(nd+sign[side]*potential(v),v);
+            }
+            // every vertex reached from both sides is a candidate meeting point
+            if (other.reached(v) && me.dist(v)+other.dist(v)<best) {
+                best=me.dist(v)+other.dist(v);
+                meet=v;
+            }
+        }
+    }
+    if (meet==-1) return {INF,{}};
+    vector<int> path=fwd.path(start,meet);
+    for (int x=bwd.parent(meet); x!=-1; x=bwd.parent(x)) path.push_back(x);
+    return {best,path};
+}
+pair<double,vector<int>> bidirectionalDijkstra(const Graph& g,int start,int goal,
+                                               SearchWorkspace& fwd,SearchWorkspace& bwd,int* settled) {
+    return bidirectionalSearch(g,start,goal,[](int) { return 0.0; },fwd,bwd,settled);
+}
+pair<double,vector<int>> bidirectionalAStar(const Graph& g,int start,int goal,const LandmarkIndex& landmarks,
+                                            SearchWorkspace& fwd,SearchWorkspace& bwd,int* settled) {
+    auto potential=[&](int v) {
+        return 0.5*(landmarks.lowerBound(v,goal)-landmarks.lowerBound(start,v));
+    };
+    return bidirectionalSearch(g,start,goal,potential,fwd,bwd,settled);
+}
+pair<double,vector<int>> bidirectionalDijkstra(const Graph& g,int start,int goal,int* settled) {
+    return bidirectionalDijkstra(g,start,goal,SearchWorkspace::forThread(0),SearchWorkspace::forThread(1),settled);
+}
+pair<double,vector<int>> bidirectionalAStar(const Graph& g,int start,int goal,
+                                            const LandmarkIndex& landmarks,int* settled) {
+    return bidirectionalAStar(g,start,goal,landmarks,SearchWorkspace::forThread(0),SearchWorkspace::forThread(1),settled);
+}
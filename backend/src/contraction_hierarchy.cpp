@@ -0,0 +1,285 @@
+#include "../include/contraction_hierarchy.h"
+#include "../include/graph.h"
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+static const double CH_INF=numeric_limits<double>::infinity();
+// witness searches give up after this many settled vertices; a missed
+// witness only costs an unnecessary shortcut, never a wrong answer
+static const int WITNESS_SETTLE_LIMIT=500;
+namespace {
+struct Arc { int to; double w; int middle; };
+typedef pair<double,int> P;
+// Mutable state used only while building the hierarchy.
+struct Contractor {
+    int n;
+    vector<vector<Arc>> adj;
+    vector<bool> contracted;
+    vector<int> deletedNeighbors;
+    // witness search scratch, reset through `touched`
+    vector<double> wdist;
+    vector<int> touched;
+    explicit Contractor(int n):n(n),adj(n),contracted(n,false),deletedNeighbors(n,0),wdist(n,CH_INF) {}
+    void addArc(int u,int v,double w,int middle) {
+        // keep one arc per pair, the cheapest
+        for (Arc& a:adj[u]) {
+            if (a.to==v) {
+                if (w<a.w) { a.w=w; a.middle=middle; }
+                return;
+            }
+        }
+        adj[u].push_back({v,w,middle});
+    }
+    // Dijkstra from `src` over uncontracted vertices, never through `skip`
+    void witnessSearch(int src,int skip,double maxDist) {
+        for (int v:touched) wdist[v]=CH_INF;
+        touched.clear();
+        priority_queue<P,vector<P>,greater<P>> pq;
+        wdist[src]=0; touched.push_back(src);
+        pq.push(P(0.0,src));
+        int settled=0;
+        while (!pq.empty()) {
+            P top=pq.top(); pq.pop();
+            double d=top.first; int u=top.second;
+            if (d>wdist[u]) continue;
+            if (d>maxDist || ++settled>WITNESS_SETTLE_LIMIT) break;
+            for (const Arc& a:adj[u]) {
+                if (a.to==skip || contracted[a.to]) continue;
+                double nd=d+a.w;
+                if (nd<wdist[a.to]) {
+                    if (wdist[a.to]==CH_INF) touched.push_back(a.to);
+                    wdist[a.to]=nd;
+                    pq.push(P(nd,a.to));
+                }
+            }
+        }
+    }
+    // Shortcuts needed to contract v; inserted unless `simulate`.
+    int contract(int v,bool simulate) {
+        vector<Arc> nbrs;
+        for (const Arc& a:adj[v]) if (!contracted[a.to]) nbrs.push_back(a);
+        int added=0;
+        for (size_t i=0; i+1<nbrs.size(); ++i) {
+            double maxOut=0;
+            for (size_t j=i+1; j<nbrs.size(); ++j) maxOut=max(maxOut,nbrs[j].w);
+            witnessSearch(nbrs[i].to,v,nbrs[i].w+maxOut);
+            for (size_t j=i+1; j<nbrs.size(); ++j) {
+                int u=nbrs[i].to,x=nbrs[j].to;
+                double via=nbrs[i].w+nbrs[j].w;
+                if (wdist[x]<=via) continue; // witness found
+                ++added;
+                if (!simulate) { addArc(u,x,via,v); addArc(x,u,via,v); }
+            }
+        }
+        return added;
+    }
+    int priority(int v) {
+        int removed=0;
+        for (const Arc& a:adj[v]) if (!contracted[a.to]) ++removed;
+        return 2*(contract(v,true)-removed)+deletedNeighbors[v];
+    }
+};
+}
+void ContractionHierarchy::build(const Graph& g) {
+    CSRView c=g.csr();
+    n=c.numNodes;
+    shortcuts=0;
+    rank.assign(n,-1);
+    valid.assign(n,false);
+    upOffsets.assign(n+1,0);
+    upArcs.clear();
+    if (n<=0) return;
+    Contractor ct(n);
+    for (int u=0; u<n; ++u) {
+        valid[u]=g.isValidAttraction(u);
+        for (int e=c.offsets[u]; e<c.offsets[u+1]; ++e)
+            if (c.targets[e]!=u) ct.addArc(u,c.targets[e],c.weights[e],-1);
+    }
+    // lazy-updated contraction order: re-evaluate the cheapest vertex and
+    // only contract it if it is still no worse than the next candidate
+    priority_queue<P,vector<P>,greater<P>> order;
+    for (int v=0; v<n; ++v) order.push(P(ct.priority(v),v));
+    vector<vector<UpArc>> up(n);
+    int next=0;
+    while (!order.empty()) {
+        int v=order.top().second; order.pop();
+        if (ct.contracted[v]) continue;
+        double p=ct.priority(v);
+        if (!order.empty() && p>order.top().first) { order.push(P(p,v)); continue; }
+        shortcuts+=ct.contract(v,false);
+        ct.contracted[v]=true;
+        rank[v]=next++;
+        // every arc still pointing at an uncontracted vertex goes upward
+        for (const Arc& a:ct.adj[v]) {
+            if (ct.contracted[a.to]) continue;
+            up[v].push_back({a.to,a.w,a.middle});
+            ct.deletedNeighbors[a.to]++;
+            auto& back=ct.adj[a.to];
+            for (size_t k=0; k<back.size(); ++k)
+                if (back[k].to==v) { back[k]=back.back(); back.pop_back(); break; }
+        }
+        vector<Arc>().swap(ct.adj[v]);
+    }
+    for (int v=0; v<n; ++v) upOffsets[v+1]=upOffsets[v]+(int)up[v].size();
+    upArcs.reserve(upOffsets[n]);
+    for (int v=0; v<n; ++v) upArcs.insert(upArcs.end(),up[v].begin(),up[v].end());
+}
+namespace {
+// Dense per-thread query buffers, reset through the touched lists so a
+// query costs only its search space, not O(n).
+struct QueryScratch {
+    vector<double> dist[2];
+    vector<int> parent[2];
+    vector<int> touched[2];
+    void prepare(int n) {
+        for (int s=0; s<2; ++s) {
+            if ((int)dist[s].size()<n) { dist[s].resize(n,CH_INF); parent[s].resize(n,-1); }
+            for (int v:touched[s]) { dist[s][v]=CH_INF; parent[s][v]=-1; }
+            touched[s].clear();
+        }
+    }
+};
+QueryScratch& queryScratch(int n) {
+    static thread_local QueryScratch qs;
+    qs.prepare(n);
+    return qs;
+}
+}
+// Stall-on-demand: arcs of u to higher ranked vertices are also the arcs
+// *into* u from above, so if one of those offers a shorter way to u, the
+// upward search never needs to expand u.
+bool ContractionHierarchy::stalled(const vector<double>& dist,int u,double d) const {
+    for (int e=upOffsets[u]; e<upOffsets[u+1]; ++e)
+        if (dist[upArcs[e].to]+upArcs[e].weight<d) return true;
+    return false;
+}
+void ContractionHierarchy::upwardSearch(int s,vector<pair<int,double>>& settled) const {
+    settled.clear();
+    QueryScratch& qs=queryScratch(n);
+    vector<double>& dist=qs.dist[0];
+    priority_queue<P,vector<P>,greater<P>> pq;
+    dist[s]=0; qs.touched[0].push_back(s);
+    pq.push(P(0.0,s));
+    while (!pq.empty()) {
+        P top=pq.top(); pq.pop();
+        double d=top.first; int u=top.second;
+        if (d>dist[u]) continue;
+        if (stalled(dist,u,d)) continue;
+        settled.push_back({u,d});
+        for (int e=upOffsets[u]; e<upOffsets[u+1]; ++e) {
+            const UpArc& a=upArcs[e];
+            double nd=d+a.weight;
+            if (nd<dist[a.to]) {
+                if (dist[a.to]==CH_INF) qs.touched[0].push_back(a.to);
+                dist[a.to]=nd;
+                pq.push(P(nd,a.to));
+            }
+        }
+    }
+}
+double ContractionHierarchy::query(int s,int t,vector<int>* path) const {
+    if (path) path->clear();
+    if (s<0 || t<0 || s>=n || t>=n || !valid[s] || !valid[t]) return CH_INF;
+    if (s==t) { if (path) path->push_back(s); return 0; }
+    // index 0 = forward from s, 1 = backward from t; both climb the same upward graph
+    QueryScratch& qs=queryScratch(n);
+    vector<double>* dist=qs.dist;
+    vector<int>* parent=qs.parent;
+    priority_queue<P,vector<P>,greater<P>> pq[2];
+    dist[0][s]=0; qs.touched[0].push_back(s); pq[0].push(P(0.0,s));
+    dist[1][t]=0; qs.touched[1].push_back(t); pq[1].push(P(0.0,t));
+    double best=CH_INF; int meet=-1;
+    int side=0;
+    while (!pq[0].empty() || !pq[1].empty()) {
+        if (pq[side].empty()) side^=1;
+        P top=pq[side].top(); pq[side].pop();
+        double d=top.first; int u=top.second;
+        // a direction is finished once its queue cannot beat the best meeting
+        if (d>=best) {
+            priority_queue<P,vector<P>,greater<P>>().swap(pq[side]);
+            side^=1;
+            continue;
+        }
+        if (d>dist[side][u] || stalled(dist[side],u,d)) { side^=1; continue; }
+        if (d+dist[side^1][u]<best) { best=d+dist[side^1][u]; meet=u; }
+        for (int e=upOffsets[u]; e<upOffsets[u+1]; ++e) {
+            const UpArc& a=upArcs[e];
+            double nd=d+a.weight;
+            if (nd<dist[side][a.to]) {
+                if (dist[side][a.to]==CH_INF) qs.touched[side].push_back(a.to);
+                dist[side][a.to]=nd;
+                parent[side][a.to]=u;
+                pq[side].push(P(nd,a.to));
+            }
+        }
+        side^=1;
+    }
+    if (meet==-1 || !path) return best;
+    // s ... meet via forward parents, then meet ... t via backward parents
+    vector<int> up;
+    for (int x=meet; x!=-1; x=parent[0][x]) up.push_back(x);
+    reverse(up.begin(),up.end());
+    for (int x=parent[1][meet]; x!=-1; x=parent[1][x]) up.push_back(x);
+    path->push_back(up[0]);
+    for (size_t i=0; i+1<up.size(); ++i) unpack(up[i],up[i+1],*path);
+    return best;
+}
+const ContractionHierarchy::UpArc* ContractionHierarchy::findArc(int a,int b) const {
+    int lo=rank[a]<rank[b] ? a : b;
+    int hi=(lo==a) ? b : a;
+    for (int e=upOffsets[lo]; e<upOffsets[lo+1]; ++e)
+        if (upArcs[e].to==hi) return &upArcs[e];
+    return nullptr;
+}
+// Append the original vertices of arc a->b (excluding a) to `out`.
+void ContractionHierarchy::unpack(int a,int b,vector<int>& out) const {
+    // explicit stack: shortcut nesting can be deep on large graphs
+    vector<pair<int,int>> stack;
+    stack.push_back({a,b});
+    while (!stack.empty()) {
+        pair<int,int> cur=stack.back(); stack.pop_back();
+        const UpArc* arc=findArc(cur.first,cur.second);
+        if (!arc || arc->middle==-1) { out.push_back(cur.second); continue; }
+        // second half pushed first so the first half is expanded first
+        stack.push_back({arc->middle,cur.second});
+        stack.push_back({cur.first,arc->middle});
+    }
+}
+double ContractionHierarchy::distance(int s,int t) const {
+    return query(s,t,nullptr);
+}
+pair<double,vector<int>> ContractionHierarchy::shortestPath(int s,int t) const {
+    vector<int> path;
+    double d=query(s,t,&path);
+    return {d,path};
+}
+DistanceMatrix ContractionHierarchy::distanceMatrix(const vector<int>& locs) const {
+    int k=(int)locs.size();
+    DistanceMatrix dist(k,vector<double>(k,CH_INF));
+    for (int i=0; i<k; ++i) dist[i][i]=0;
+    // every location's upward search space is both its bucket entries
+    // (as a target) and its scan list (as a source)
+    vector<vector<pair<int,double>>> spaces(k);
+    unordered_map<int,vector<pair<int,double>>> buckets;
+    for (int j=0; j<k; ++j) {
+        int t=locs[j];
+        if (t<0 || t>=n || !valid[t]) continue;
+        upwardSearch(t,spaces[j]);
+        for (auto& sv:spaces[j]) buckets[sv.first].push_back({j,sv.second});
+    }
+    for (int i=0; i<k; ++i) {
+        for (auto& sv:spaces[i]) {
+            auto it=buckets.find(sv.first);
+            if (it==buckets.end()) continue;
+            for (auto& jt:it->second) {
+                double d=sv.second+jt.second;
+                if (d<dist[i][jt.first]) dist[i][jt.first]=d;
+            }
+        }
+        dist[i][i]=0;
+    }
+    return dist;
+}
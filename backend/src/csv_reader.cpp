@@ -0,0 +1,117 @@
+#include "../include/csv_reader.h"
+#include <charconv>
+#include <cstring>
+using namespace std;
+static const size_t CSV_BLOCK=1<<20;
+CsvReader::CsvReader(char delimiter):delimiter(delimiter) {}
+CsvReader::~CsvReader() { if (file) fclose(file); }
+bool CsvReader::open(const string& path) {
+    if (file) fclose(file);
+    file=fopen(path.c_str(),"rb");
+    buffer.resize(CSV_BLOCK);
+    begin=end=0;
+    eof=file==nullptr;
+    line=0;
+    return file!=nullptr;
+}
+long long CsvReader::countLines(const string& path) {
+    FILE* f=fopen(path.c_str(),"rb");
+    if (!f) return -1;
+    vector<char> block(CSV_BLOCK);
+    long long lines=0;
+    size_t got;
+    while ((got=fread(block.data(),1,block.size(),f))>0) {
+        for (const char* p=block.data(); (p=(const char*)memchr(p,'\n',block.data()+got-p)); ++p) ++lines;
+    }
+    fclose(f);
+    return lines;
+}
+// keep the unread tail, then top the block up from the file; a line longer
+// than the block doubles it
+bool CsvReader::refill() {
+    if (begin>0) {
+        memmove(buffer.data(),buffer.data()+begin,end-begin);
+        end-=begin;
+        begin=0;
+    }
+    if (end==buffer.size()) buffer.resize(buffer.size()*2);
+    size_t got=fread(buffer.data()+end,1,buffer.size()-end,file);
+    end+=got;
+    if (got==0) eof=true;
+    return got>0;
+}
+bool CsvReader::next() {
+    size_t scanned=begin;
+    while (true) {
+        const char* base=buffer.data();
+        const char* nl=(const char*)memchr(base+scanned,'\n',end-scanned);
+        size_t stop;
+        if (nl) {
+            stop=nl-base;
+        } else if (!eof) {
+            size_t seen=end-begin;
+            refill();
+            scanned=begin+seen;
+            continue;
+        } else if (begin<end) {
+            stop=end;   // last line has no newline
+        } else {
+            fields.clear();
+            return false;
+        }
+        size_t start=begin;
+        begin=min(stop+1,end);
+        scanned=begin;
+        ++line;
+        size_t len=stop-start;
+        if (len>0 && base[start+len-1]=='\r') --len;
+        if (len==0) continue;
+        fields.clear();
+        const char* p=base+start;
+        const char* last=p+len;
+        if (delimiter==' ') {
+            while (p<last) {
+                while (p<last && (*p==' ' || *p=='\t')) ++p;
+                const char* q=p;
+                while (q<last && *q!=' ' && *q!='\t') ++q;
+                if (q>p) fields.emplace_back(p,q-p);
+                p=q;
+            }
+            if (fields.empty()) continue;
+            return true;
+        }
+        while (true) {
+            const char* q=(const char*)memchr(p,delimiter,last-p);
+            if (!q) { fields.emplace_back(p,last-p); break; }
+            fields.emplace_back(p,q-p);
+            p=q+1;
+        }
+        return true;
+    }
+}
+// field i without surrounding spaces, and without a leading '+' that
+// from_chars would refuse
+static string_view numberText(string_view s) {
+    while (!s.empty() && (s.front()==' ' || s.front()=='\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back()==' ' || s.back()=='\t')) s.remove_suffix(1);
+    if (s.size()>1 && s.front()=='+') s.remove_prefix(1);
+    return s;
+}
+bool CsvReader::number(int i,double& out) const {
+    string_view s=numberText(field(i));
+    if (s.empty()) return true;
+    double v;
+    auto r=from_chars(s.data(),s.data()+s.size(),v);
+    if (r.ec!=errc() || r.ptr!=s.data()+s.size()) return false;
+    out=v;
+    return true;
+}
+bool CsvReader::number(int i,int& out) const {
+    string_view s=numberText(field(i));
+    if (s.empty()) return true;
+    int v;
+    auto r=from_chars(s.data(),s.data()+s.size(),v);
+    if (r.ec!=errc() || r.ptr!=s.data()+s.size()) return false;
+    out=v;
+    return true;
+}
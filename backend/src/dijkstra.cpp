@@ -1,66 +1,78 @@
 #include "../include/algorithms.h"
 #include "../include/graph.h"
-#include <queue>
+#include "../include/search_workspace.h"
 #include <vector>
 #include <limits>
 #include <algorithm>
 using namespace std;
-vector<double> dijkstra(const Graph& g,int start) {
-    int maxId=g.maxNodeId();
-    int n=maxId+1;
-    if (n<=0) return vector<double>();
-    vector<double> dist(n,numeric_limits<double>::infinity());
-    typedef pair<double,int> P;
-    priority_queue<P,vector<P>,greater<P>> pq;
-    if (!g.isValidAttraction(start)) return dist;
-    dist[start]=0.0;
-    pq.push(P(0.0,start));
-    while (!pq.empty()) {
-        P top=pq.top(); pq.pop();
+// Core loop shared by every Dijkstra flavour. Stops early once all marked
+// targets are settled (when `remaining` > 0) or the frontier passes maxDist.
+static void runDijkstra(const Graph& g,int start,SearchWorkspace& ws,int remaining,double maxDist) {
+    bool allTargets=remaining==0;
+    ws.setLabel(start,0.0,-1);
+    ws.push(0.0,start);
+    while (!ws.heapEmpty() && (allTargets || remaining>0)) {
+        pair<double,int> top=ws.pop();
         double d=top.first;
         int u=top.second;
-        if (d>dist[u]) continue;
-        auto nbrs=g.getNeighbors(u);
-        for (size_t i=0; i<nbrs.size(); ++i) {
-            int v=nbrs[i].first;
-            double w=nbrs[i].second;
-            if (v<0 || v>=(int)dist.size()) continue;
-            if (dist[v]>d+w) {
-                dist[v]=d+w;
-                pq.push(P(dist[v],v));
+        if (d>ws.dist(u)) continue;
+        if (d>maxDist) break;
+        ws.settle(u);
+        if (ws.marked(u)) { ws.unmark(u); --remaining; }
+        for (Neighbor nb:g.getNeighbors(u)) {
+            int v=nb.id;
+            double w=nb.weight;
+            if (ws.dist(v)>d+w) {
+                ws.setLabel(v,d+w,u);
+                ws.push(d+w,v);
             }
         }
     }
+}
+void dijkstra(const Graph& g,int start,SearchWorkspace& ws) {
+    int n=g.csr().numNodes;
+    ws.reset(n);
+    if (n<=0 || !g.isValidAttraction(start)) return;
+    runDijkstra(g,start,ws,0,numeric_limits<double>::infinity());
+}
+vector<double> dijkstra(const Graph& g,int start) {
+    int n=g.csr().numNodes;
+    if (n<=0) return vector<double>();
+    SearchWorkspace& ws=SearchWorkspace::forThread();
+    dijkstra(g,start,ws);
+    vector<double> dist(n);
+    for (int v=0; v<n; ++v) dist[v]=ws.dist(v);
     return dist;
 }
 pair<vector<double>,vector<int>> dijkstraWithPath(const Graph& g,int start) {
-    int maxId=g.maxNodeId();
-    int n=maxId+1;
+    int n=g.csr().numNodes;
+    if (n<=0) return {vector<double>(),vector<int>()};
+    SearchWorkspace& ws=SearchWorkspace::forThread();
+    dijkstra(g,start,ws);
+    vector<double> dist(n);
+    vector<int> parent(n);
+    for (int v=0; v<n; ++v) { dist[v]=ws.dist(v); parent[v]=ws.parent(v); }
+    return {dist,parent};
+}
+void dijkstraToTargets(const Graph& g,int start,const vector<int>& targets,SearchWorkspace& ws,double maxDist) {
+    int n=g.csr().numNodes;
+    ws.reset(n);
+    if (n<=0 || !g.isValidAttraction(start)) return;
+    // marked = still waiting to be settled (targets may repeat)
+    int remaining=0;
+    for (int t:targets) if (t>=0 && t<n && !ws.marked(t)) { ws.mark(t); ++remaining; }
+    if (remaining==0) return;
+    runDijkstra(g,start,ws,remaining,maxDist);
+}
+pair<vector<double>,vector<int>> dijkstraToTargets(const Graph& g,int start,const vector<int>& targets,double maxDist) {
+    int n=g.csr().numNodes;
     if (n<=0) return {vector<double>(),vector<int>()};
+    SearchWorkspace& ws=SearchWorkspace::forThread();
+    dijkstraToTargets(g,start,targets,ws,maxDist);
+    // keep settled labels only, so callers never mistake tentative ones for shortest distances
     vector<double> dist(n,numeric_limits<double>::infinity());
     vector<int> parent(n,-1);
-    typedef pair<double,int> P;
-    priority_queue<P,vector<P>,greater<P>> pq;
-    if (!g.isValidAttraction(start)) return {dist,parent};
-    dist[start]=0.0;
-    pq.push(P(0.0,start));
-    while (!pq.empty()) {
-        P top=pq.top(); pq.pop();
-        double d=top.first;
-        int u=top.second;
-        if (d>dist[u]) continue;
-        auto nbrs=g.getNeighbors(u);
-        for (size_t i=0; i<nbrs.size(); ++i) {
-            int v=nbrs[i].first;
-            double w=nbrs[i].second;
-            if (v<0 || v>=(int)dist.size()) continue;
-            if (dist[v]>d+w) {
-                dist[v]=d+w;
-                parent[v]=u;
-                pq.push(P(dist[v],v));
-            }
-        }
-    }
+    for (int v=0; v<n; ++v) if (ws.settled(v)) { dist[v]=ws.dist(v); parent[v]=ws.parent(v); }
     return {dist,parent};
 }
 vector<int> reconstructPath(const vector<int>& parent,int start,int end) {
@@ -0,0 +1,37 @@
+#include "../include/algorithms.h"
+#include "../include/graph.h"
+#include "../include/search_workspace.h"
+#include <vector>
+#include <limits>
+using namespace std;
+// Many-to-many table: one dijkstraToTargets per source, which stops as soon
+// as every remaining target is settled instead of exhausting the graph.
+// Roads are undirected (Graph::addEdge inserts both directions), so row i
+// only has to settle targets j>i and mirrors them into column i.
+DistanceMatrix buildDistanceMatrix(const Graph& g,const vector<int>& locs,SearchWorkspace& ws) {
+    const double INF=numeric_limits<double>::infinity();
+    int n=(int)locs.size();
+    DistanceMatrix dist(n,vector<double>(n,INF));
+    for (int i=0; i<n; ++i) dist[i][i]=0;
+    int N=g.csr().numNodes;
+    if (N<=0 || n<2) return dist;
+    vector<bool> valid(n,false);
+    for (int j=0; j<n; ++j) valid[j]=locs[j]>=0 && locs[j]<N && g.isValidAttraction(locs[j]);
+    vector<int> targets;
+    for (int i=0; i<n; ++i) {
+        if (!valid[i]) continue;
+        targets.clear();
+        for (int j=i+1; j<n; ++j) if (valid[j]) targets.push_back(locs[j]);
+        if (targets.empty()) break;
+        dijkstraToTargets(g,locs[i],targets,ws);
+        for (int j=i+1; j<n; ++j) {
+            if (!valid[j] || !ws.settled(locs[j])) continue;
+            dist[i][j]=ws.dist(locs[j]);
+            dist[j][i]=dist[i][j];
+        }
+    }
+    return dist;
+}
+DistanceMatrix buildDistanceMatrix(const Graph& g,const vector<int>& locs) {
+    return buildDistanceMatrix(g,locs,SearchWorkspace::forThread());
+}
@@ -1,37 +1,123 @@
 #include "../include/graph.h"
-#include <fstream>
+#include <charconv>
+#include <cstdio>
 #include <sstream>
 #include <iostream>
 #include <limits>
+#include <algorithm>
 #include "../include/algorithms.h" // for Edge type in getAllEdges
+#include "../include/snapshot.h"
+#include "../include/csv_reader.h"
 using namespace std;
-Graph::Graph():numVertices(0),dsu(nullptr) {}
-Graph::~Graph() { if (dsu) delete dsu; }
+bool parseClockTime(const string& text,double& minutes) {
+    int h=0,m=0;
+    char colon=0,extra=0;
+    if (sscanf(text.c_str()," %d %c %d %c",&h,&colon,&m,&extra)!=3 || colon!=':') return false;
+    if (h<0 || h>24 || m<0 || m>59 || (h==24 && m!=0)) return false;
+    minutes=h*60+m;
+    return true;
+}
+bool parseOpeningHours(const string& text,OpenWindows& windows) {
+    windows.clear();
+    size_t first=text.find_first_not_of(" \t\r");
+    if (first==string::npos) return true;
+    size_t last=text.find_last_not_of(" \t\r");
+    string trimmed=text.substr(first,last-first+1);
+    if (trimmed=="24/7") return true;
+    stringstream ss(trimmed);
+    string range;
+    while (getline(ss,range,';')) {
+        size_t dash=range.find('-');
+        double open,close;
+        if (dash==string::npos || !parseClockTime(range.substr(0,dash),open) ||
+            !parseClockTime(range.substr(dash+1),close)) {
+            windows.clear();
+            return false;
+        }
+        if (close<=open) close+=1440;
+        windows.push_back({open,close});
+    }
+    sort(windows.begin(),windows.end());
+    return true;
+}
+Graph::Graph():numVertices(0),maxId(-1),dsu(nullptr) {}
+Graph::~Graph() {
+    releaseSnapshot();
+    if (dsu) delete dsu;
+}
+void Graph::clearAll() {
+    releaseSnapshot();
+    attractions.clear();
+    adjList.clear();
+    nameToId.clear();
+    csrOffsets.clear();
+    csrTargets.clear();
+    csrWeights.clear();
+    numVertices=0;
+    maxId=-1;
+    if (dsu) { delete dsu; dsu=nullptr; }
+}
 void Graph::addAttraction(const Attraction& attr) {
+    detachSnapshot();
     attractions[attr.id]=attr;
     if (!attr.name.empty()) nameToId[attr.name]=attr.id;
     if (adjList.find(attr.id)==adjList.end())
         adjList[attr.id]=vector<pair<int,double>>();
     numVertices=(int)attractions.size();
+    maxId=max(maxId,attr.id);
+    csrOffsets.clear(); // stale until the next buildCSR()
 }
 void Graph::addEdge(int from,int to,double weight) {
     if (from==to) return;
+    detachSnapshot();
+    csrOffsets.clear();
+    maxId=max(maxId,max(from,to));
     if (adjList.find(from)==adjList.end()) adjList[from]={};
     if (adjList.find(to)==adjList.end()) adjList[to]={};
     adjList[from].push_back({to,weight});
     adjList[to].push_back({from,weight});
 }
-vector<pair<int,double>> Graph::getNeighbors(int nodeId) const {
-    auto it=adjList.find(nodeId);
-    if (it==adjList.end()) return {};
-    return it->second;
+NeighborRange Graph::getNeighbors(int nodeId) const {
+    CSRView c=csr();
+    if (nodeId<0 || nodeId>=c.numNodes) return NeighborRange();
+    int b=c.offsets[nodeId];
+    return NeighborRange(c.targets+b,c.weights+b,c.offsets[nodeId+1]-b);
 }
-Attraction Graph::getAttraction(int id) const {
+const Attraction& Graph::getAttraction(int id) const {
+    static const Attraction missing;
+    if (snapBase) {
+        const SnapshotNode* r=snapRecord(id);
+        if (!r) return missing;
+        lock_guard<mutex> lock(snapLock);
+        auto it=snapAttractions.find(id);
+        if (it==snapAttractions.end()) it=snapAttractions.emplace(id,snapAttraction(*r)).first;
+        return it->second;
+    }
     auto it=attractions.find(id);
-    if (it==attractions.end()) return Attraction();
+    if (it==attractions.end()) return missing;
     return it->second;
 }
+bool Graph::getCoordinates(int id,double& latitude,double& longitude) const {
+    if (snapBase) {
+        const SnapshotNode* r=snapRecord(id);
+        if (!r) return false;
+        latitude=r->latitude;
+        longitude=r->longitude;
+        return true;
+    }
+    auto it=attractions.find(id);
+    if (it==attractions.end()) return false;
+    latitude=it->second.latitude;
+    longitude=it->second.longitude;
+    return true;
+}
 double Graph::getEdgeWeight(int from,int to) const {
+    CSRView c=csr();
+    if (c.numNodes>0) {
+        if (from<0 || from>=c.numNodes) return numeric_limits<double>::infinity();
+        for (int e=c.offsets[from]; e<c.offsets[from+1]; ++e) if (c.targets[e]==to) return c.weights[e];
+        return numeric_limits<double>::infinity();
+    }
     auto it=adjList.find(from);
     if (it==adjList.end()) return numeric_limits<double>::infinity();
     for (auto &p:it->second) if (p.first==to) return p.second;
@@ -39,27 +125,37 @@ double Graph::getEdgeWeight(int from,int to) const {
 }
 vector<int> Graph::getAllAttractionIds() const {
     vector<int> ids;
+    if (snapBase) {
+        ids.reserve(snapRecords);
+        for (int i=0; i<snapRecords; ++i) ids.push_back(snapNodes[i].id);
+        return ids;
+    }
     ids.reserve(attractions.size());
     for (auto &kv:attractions) ids.push_back(kv.first);
     return ids;
 }
 bool Graph::hasAttraction(int id) const {
+    if (snapBase) return snapRecord(id)!=nullptr;
     return attractions.find(id) != attractions.end();
 }
 int Graph::getIdByName(const string& name) const {
+    if (snapBase) {
+        // binary search the snapshot's sorted name index, no map to build
+        int lo=0,hi=snapNames;
+        while (lo<hi) {
+            int mid=(lo+hi)/2;
+            const SnapshotNode& rec=snapNodes[snapNameIndex[mid]];
+            int c=name.compare(0,string::npos,snapStrings+rec.name.at,rec.name.length);
+            if (c==0) return rec.id;
+            if (c>0) lo=mid+1;
+            else hi=mid;
+        }
+        return -1;
+    }
     auto it=nameToId.find(name);
     if (it==nameToId.end()) return -1;
     return it->second;
 }
-int Graph::maxNodeId() const {
-    int maxId=-1;
-    for (auto &kv:attractions) if (kv.first > maxId) maxId=kv.first;
-    for (auto &kv:adjList) {
-        if (kv.first > maxId) maxId=kv.first;
-        for (auto &p:kv.second) if (p.first > maxId) maxId=p.first;
-    }
-    return maxId;
-}
 bool Graph::isValidAttraction(int id) const {
     return hasAttraction(id);
 }
@@ -71,95 +167,199 @@ bool Graph::isFullyConnected() const {
     for (int id:ids) if (dsu->find(id) != root) return false;
     return true;
 }
-void Graph::buildDSU() {
-    if (dsu) { delete dsu; dsu=nullptr; }
-    int maxId=maxNodeId();
-    if (maxId < 0) return;
-    dsu=new DSU(maxId+1);
+void Graph::buildCSR() {
+    detachSnapshot();
+    // vertex ids are dense (0..n-1 from the CSV loader), so index by id directly
+    int n=maxNodeId()+1;
+    csrOffsets.assign(n+1,0);
+    csrTargets.clear();
+    csrWeights.clear();
+    if (n<=0) return;
+    for (auto &kv:adjList) csrOffsets[kv.first+1]=(int)kv.second.size();
+    for (int u=0; u<n; ++u) csrOffsets[u+1]+=csrOffsets[u];
+    csrTargets.resize(csrOffsets[n]);
+    csrWeights.resize(csrOffsets[n]);
     for (auto &kv:adjList) {
-        int u=kv.first;
+        int pos=csrOffsets[kv.first];
+        // keep insertion order so ties resolve exactly as they did on adjList
         for (auto &p:kv.second) {
-            int v=p.first;
-            if (v >= 0) dsu->unite(u,v);
-            }
+            csrTargets[pos]=p.first;
+            csrWeights[pos]=p.second;
+            ++pos;
         }
+    }
+}
+CSRView Graph::csr() const {
+    if (snapBase) return snapCSR;
+    CSRView c;
+    if (csrOffsets.size()<2) return c;
+    c.offsets=csrOffsets.data();
+    c.targets=csrTargets.data();
+    c.weights=csrWeights.data();
+    c.numNodes=(int)csrOffsets.size()-1;
+    return c;
+}
+void Graph::buildDSU() {
+    if (dsu) { delete dsu; dsu=nullptr; }
+    CSRView c=csr();
+    if (c.numNodes<=0) return;
+    dsu=new DSU(c.numNodes);
+    for (int u=0; u<c.numNodes; ++u)
+        for (int e=c.offsets[u]; e<c.offsets[u+1]; ++e) dsu->unite(u,c.targets[e]);
 }
 // CSV loader expecting attractions.csv header: name,category,rating,duration,fee,popularity,latitude,longitude
 // and roads.csv header: from,to,time (names)
+// Rows stream through CsvReader; a bad value is reported with its file and
+// line (the first CSV_MAX_REPORTS of them) and the rest of the row still used.
+static const int CSV_MAX_REPORTS=20;
 void Graph::loadFromCSV(const string& attractionsFile,const string& roadsFile) {
-    attractions.clear();
-    adjList.clear();
-    nameToId.clear();
-    //above 3 lines are required to CLEAR any
+    clearAll();
+    //above line is required to CLEAR any
     //old stored nodes/adj lists from prior,so cleared every single time(important)
-    numVertices=0;
-    if (dsu) { delete dsu; dsu=nullptr; }
-    ifstream aif(attractionsFile);
-    if (!aif.is_open()) {
+    CsvReader in;
+    if (!in.open(attractionsFile)) {
         cerr<<"[graph] cannot open attractions file: "<<attractionsFile<<"\n";
         return;
     }
     //catches error just in case file cannot be opened
-    string line;
+    int problems=0;
+    auto report=[&](const string& file,const string& what) {
+        if (++problems<=CSV_MAX_REPORTS) cerr<<"[graph] "<<file<<":"<<in.lineNumber()<<": "<<what<<"\n";
+    };
+    auto bad=[&](const string& file,const char* column,int i) {
+        report(file,string("bad ")+column+" \""+string(in.field(i))+"\"");
+    };
     // read header
-    if (!getline(aif,line)) { aif.close(); return; }
+    if (!in.next()) return;
+    // road endpoints resolve through views of the stored names, no strings built
+    unordered_map<string_view,int> byName;
+    // one cheap newline count saves rehashing the tables row by row
+    long long rows=CsvReader::countLines(attractionsFile);
+    if (rows>0) {
+        attractions.reserve(rows);
+        adjList.reserve(rows);
+        byName.reserve(rows);
+    }
     int nextId=0;
-    while (getline(aif,line)) {
-        if (line.empty()) continue;
-        stringstream ss(line);
+    while (in.next()) {
         Attraction at;
         at.id=nextId++;
-        string latS,lonS,ratingS,durationS,feeS,popS;
-        getline(ss,at.name,',');
-        getline(ss,at.category,',');
-        getline(ss,ratingS,',');
-        getline(ss,durationS,',');
-        getline(ss,feeS,',');
-        getline(ss,popS,',');
-        getline(ss,latS,',');
-        getline(ss,lonS,',');
-        try {
-            if (!ratingS.empty()) at.rating=stod(ratingS);
-            if (!durationS.empty()) at.visitDuration=stod(durationS);
-            if (!feeS.empty()) at.entryFee=stod(feeS);
-            if (!popS.empty()) at.popularity=stoi(popS);
-            if (!latS.empty()) at.latitude=stod(latS);
-            if (!lonS.empty()) at.longitude=stod(lonS);
-        } catch (...) { /* ignore parse errors */ }
+        at.name=in.field(0);
+        at.category=in.field(1);
+        if (!in.number(2,at.rating)) bad(attractionsFile,"rating",2);
+        if (!in.number(3,at.visitDuration)) bad(attractionsFile,"duration",3);
+        if (!in.number(4,at.entryFee)) bad(attractionsFile,"fee",4);
+        if (!in.number(5,at.popularity)) bad(attractionsFile,"popularity",5);
+        if (!in.number(6,at.latitude)) bad(attractionsFile,"latitude",6);
+        if (!in.number(7,at.longitude)) bad(attractionsFile,"longitude",7);
+        at.openingHours=in.field(8);   // optional 9th column
+        if (!parseOpeningHours(at.openingHours,at.openWindows))
+            report(attractionsFile,"unreadable openingHours for "+at.name+", treating as always open");
         addAttraction(at);
+        if (!at.name.empty()) byName[attractions[at.id].name]=at.id;
     }
-    aif.close();
-    ifstream rif(roadsFile);
-    if (!rif.is_open()) {
+    if (!in.open(roadsFile)) {
         cerr<<"[graph] cannot open roads file: "<<roadsFile<<"\n";
+        buildCSR();
         buildDSU();
         return;
     }
-    if (!getline(rif,line)) { rif.close(); buildDSU(); return; } // header
-    while (getline(rif,line)) {
-        if (line.empty()) continue;
-        stringstream ss(line);
-        string fromN,toN,wS;
-        getline(ss,fromN,',');
-        getline(ss,toN,',');
-        getline(ss,wS,',');
-        int u=getIdByName(fromN);
-        int v=getIdByName(toN);
-        double w=1.0;
-        try { if (!wS.empty()) w=stod(wS); } catch(...) {}
-        if (u != -1 && v != -1) addEdge(u,v,w);
-    }
-    rif.close();
+    if (in.next()) { // header
+        while (in.next()) {
+            if (in.fieldCount()<2) {
+                report(roadsFile,"expected from,to,time, road skipped");
+                continue;
+            }
+            auto u=byName.find(in.field(0));
+            auto v=byName.find(in.field(1));
+            double w=1.0;
+            if (!in.number(2,w)) bad(roadsFile,"time",2);
+            if (u==byName.end() || v==byName.end()) {
+                string_view missing=u==byName.end() ? in.field(0) : in.field(1);
+                report(roadsFile,"unknown attraction \""+string(missing)+"\", road skipped");
+                continue;
+            }
+            addEdge(u->second,v->second,w);
+        }
+    }
+    if (problems>CSV_MAX_REPORTS)
+        cerr<<"[graph] "<<problems<<" CSV problems in total, first "<<CSV_MAX_REPORTS<<" shown\n";
+    buildCSR();
     buildDSU();
 }
+// shortest text that parses back to exactly x
+static void appendNumber(string& out,double x) {
+    char buf[32];
+    auto r=to_chars(buf,buf+sizeof(buf),x);
+    out.append(buf,r.ptr);
+}
+bool Graph::saveCSV(const string& attractionsFile,const string& roadsFile) const {
+    CSRView c=csr();
+    if (c.numNodes==0 && numVertices>0) {
+        cerr<<"[graph] saveCSV needs the CSR, call buildCSR() first\n";
+        return false;
+    }
+    vector<int> ids=getAllAttractionIds();
+    sort(ids.begin(),ids.end());
+    bool hours=false;
+    for (int id:ids) {
+        const Attraction& a=getAttraction(id);
+        if (a.name.empty()) {
+            cerr<<"[graph] saveCSV: attraction "<<id<<" has no name for roads.csv\n";
+            return false;
+        }
+        hours=hours || !a.openingHours.empty();
+    }
+    string text="name,category,rating,duration,fee,popularity,latitude,longitude";
+    text+=hours ? ",openingHours\n" : "\n";
+    for (int id:ids) {
+        const Attraction& a=getAttraction(id);
+        text+=a.name; text+=',';
+        text+=a.category; text+=',';
+        appendNumber(text,a.rating); text+=',';
+        appendNumber(text,a.visitDuration); text+=',';
+        appendNumber(text,a.entryFee); text+=',';
+        text+=to_string(a.popularity); text+=',';
+        appendNumber(text,a.latitude); text+=',';
+        appendNumber(text,a.longitude);
+        if (hours) { text+=','; text+=a.openingHours; }
+        text+='\n';
+    }
+    FILE* f=fopen(attractionsFile.c_str(),"wb");
+    bool ok=f && fwrite(text.data(),1,text.size(),f)==text.size();
+    if (f) ok=fclose(f)==0 && ok;
+    if (!ok) {
+        cerr<<"[graph] cannot write attractions file: "<<attractionsFile<<"\n";
+        return false;
+    }
+    // each road once, from its lower id
+    text="from,to,time\n";
+    for (int u=0; u<c.numNodes; ++u) {
+        for (int e=c.offsets[u]; e<c.offsets[u+1]; ++e) {
+            if (c.targets[e]<u) continue;
+            text+=getAttraction(u).name; text+=',';
+            text+=getAttraction(c.targets[e]).name; text+=',';
+            appendNumber(text,c.weights[e]);
+            text+='\n';
+        }
+    }
+    f=fopen(roadsFile.c_str(),"wb");
+    ok=f && fwrite(text.data(),1,text.size(),f)==text.size();
+    if (f) ok=fclose(f)==0 && ok;
+    if (!ok) {
+        cerr<<"[graph] cannot write roads file: "<<roadsFile<<"\n";
+        return false;
+    }
+    return true;
+}
 vector<Edge> Graph::getAllEdges() const {
     vector<Edge> edges;
     unordered_map<long long,bool> seen;
-    for (auto &kv:adjList) {
-        int u=kv.first;
-        for (auto &p:kv.second) {
-            int v=p.first;
-            double w=p.second;
+    CSRView c=csr();
+    for (int u=0; u<c.numNodes; ++u) {
+        for (int e=c.offsets[u]; e<c.offsets[u+1]; ++e) {
+            int v=c.targets[e];
+            double w=c.weights[e];
             int a=min(u,v),b=max(u,v);
             long long key=((long long)a<<32) | (unsigned long long)b;
             if (!seen[key]) {
@@ -0,0 +1,179 @@
+#include "../include/graph_generator.h"
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/dsu.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+using namespace std;
+namespace {
+const double GEN_LAT=26.0,GEN_LON=73.0;
+const double KM_PER_LAT=111.195;
+const double KM_PER_LON=KM_PER_LAT*cos(GEN_LAT*M_PI/180.0);
+// Adds the attractions. Their attributes come from a stream of their own,
+// so road weights (and so every benchmark) only depend on the layout.
+struct NodeMaker {
+    Graph& g;
+    mt19937 rng;
+    NodeMaker(Graph& g,unsigned seed):g(g),rng(seed^0x9e3779b9u) {}
+    void add(int id,double lat,double lon) {
+        static const char* const categories[]={"landmark","museum","park","market","temple","cafe"};
+        static const double fees[]={0,0,0,20,50,100};
+        Attraction a;
+        a.id=id;
+        a.name="N"+to_string(id);
+        a.latitude=lat;
+        a.longitude=lon;
+        a.category=categories[rng()%6];
+        a.rating=3.0+(rng()%21)/10.0;
+        a.visitDuration=10+5*(rng()%11);
+        a.entryFee=fees[rng()%6];
+        a.popularity=20+(int)(rng()%81);
+        g.addAttraction(a);
+    }
+    // at (x, y) km east and north of the origin
+    void addAt(int id,double x,double y) { add(id,GEN_LAT+y/KM_PER_LAT,GEN_LON+x/KM_PER_LON); }
+};
+// minutes for a road taking `perKm` minutes per km of straight line,
+// rounded up to 0.01 so the CSVs stay short and the bound still holds
+double roadTime(const Graph& g,int u,int v,double perKm) {
+    const Attraction& a=g.getAttraction(u);
+    const Attraction& b=g.getAttraction(v);
+    double km=haversine(a.latitude,a.longitude,b.latitude,b.longitude)/1000.0;
+    return max(0.01,ceil(km*perKm*100.0)/100.0);
+}
+}
+void generateGrid(Graph& g,int rows,int cols,unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> minutes(1,3);
+    NodeMaker nodes(g,seed);
+    const double step=0.0009; // ~100 m in latitude
+    for (int r=0; r<rows; ++r)
+        for (int c=0; c<cols; ++c) nodes.add(r*cols+c,GEN_LAT+r*step,GEN_LON+c*step);
+    for (int r=0; r<rows; ++r) {
+        for (int c=0; c<cols; ++c) {
+            int u=r*cols+c;
+            if (c+1<cols) g.addEdge(u,u+1,minutes(rng));
+            if (r+1<rows) g.addEdge(u,u+cols,minutes(rng));
+        }
+    }
+    g.buildCSR();
+    g.buildDSU();
+}
+void generateGeometric(Graph& g,int n,unsigned seed,double meanDegree) {
+    n=max(n,0);
+    mt19937 rng(seed);
+    NodeMaker nodes(g,seed);
+    double side=sqrt((double)max(n,1))*0.1;   // km, 100 points per km^2
+    uniform_real_distribution<double> coord(0,side),perKm(1.0,3.0);
+    vector<double> x(n),y(n);
+    for (int i=0; i<n; ++i) {
+        x[i]=coord(rng);
+        y[i]=coord(rng);
+        nodes.addAt(i,x[i],y[i]);
+    }
+    // expected neighbors in a circle of radius r: 100 * pi * r^2
+    double radius=sqrt(meanDegree/(M_PI*100.0));
+    // bucket the points into cells at least `radius` wide (counting sort),
+    // so each point only looks at the 3x3 cells around its own
+    int cells=max(1,min((int)(side/radius),4096));
+    double cellSize=side/cells;
+    auto cellOf=[&](double v) { return min(cells-1,(int)(v/cellSize)); };
+    vector<int> start(cells*cells+1,0),members(n);
+    for (int i=0; i<n; ++i) ++start[cellOf(y[i])*cells+cellOf(x[i])+1];
+    for (int k=0; k<cells*cells; ++k) start[k+1]+=start[k];
+    vector<int> fillAt(start.begin(),start.end()-1);
+    for (int i=0; i<n; ++i) members[fillAt[cellOf(y[i])*cells+cellOf(x[i])]++]=i;
+    for (int i=0; i<n; ++i) {
+        int cx=cellOf(x[i]),cy=cellOf(y[i]);
+        for (int gy=max(0,cy-1); gy<=min(cells-1,cy+1); ++gy) {
+            for (int gx=max(0,cx-1); gx<=min(cells-1,cx+1); ++gx) {
+                int k=gy*cells+gx;
+                for (int m=start[k]; m<start[k+1]; ++m) {
+                    int j=members[m];
+                    double dx=x[i]-x[j],dy=y[i]-y[j];
+                    if (j>i && dx*dx+dy*dy<radius*radius) g.addEdge(i,j,roadTime(g,i,j,perKm(rng)));
+                }
+            }
+        }
+    }
+    g.buildCSR();
+    g.buildDSU();
+}
+void generateRoadLike(Graph& g,int n,unsigned seed) {
+    int rows=max(1,(int)ceil(sqrt((double)max(n,1))));
+    int cols=max(1,(n+rows-1)/rows);
+    mt19937 rng(seed);
+    NodeMaker nodes(g,seed);
+    // jitter below a fifth of a block keeps every block convex, so streets
+    // plus one diagonal per block never cross: the graph stays planar
+    const double step=0.1;
+    uniform_real_distribution<double> jitter(-0.2*step,0.2*step),unit(0,1),fast(1.0,1.2),slow(1.5,3.0);
+    for (int r=0; r<rows; ++r) {
+        for (int c=0; c<cols; ++c) {
+            double dx=jitter(rng),dy=jitter(rng);
+            nodes.addAt(r*cols+c,c*step+dx,r*step+dy);
+        }
+    }
+    struct Street { int u,v; bool arterial; };
+    vector<Street> streets;
+    for (int r=0; r<rows; ++r) {
+        for (int c=0; c<cols; ++c) {
+            int u=r*cols+c;
+            if (c+1<cols) streets.push_back({u,u+1,r%8==0});
+            if (r+1<rows) streets.push_back({u,u+cols,c%8==0});
+        }
+    }
+    shuffle(streets.begin(),streets.end(),rng);
+    stable_partition(streets.begin(),streets.end(),[](const Street& s) { return s.arterial; });
+    DSU dsu(rows*cols);
+    vector<int> degree(rows*cols,0);
+    vector<char> used(streets.size(),0);
+    vector<Edge> roads;
+    auto link=[&](int u,int v,double perKm) {
+        roads.push_back({min(u,v),max(u,v),roadTime(g,u,v,perKm)});
+        ++degree[u]; ++degree[v];
+    };
+    // arterials, then a random spanning tree over the side streets: lattice
+    // links only, so no junction has more than 4 yet
+    for (size_t i=0; i<streets.size(); ++i) {
+        const Street& s=streets[i];
+        bool joins=dsu.unite(s.u,s.v);
+        if (!s.arterial && !joins) continue;
+        link(s.u,s.v,s.arterial ? fast(rng) : slow(rng));
+        used[i]=1;
+    }
+    // some of the other streets and a few diagonal shortcuts, up to degree 4
+    for (size_t i=0; i<streets.size(); ++i) {
+        const Street& s=streets[i];
+        if (!used[i] && unit(rng)<0.3 && degree[s.u]<4 && degree[s.v]<4) link(s.u,s.v,slow(rng));
+    }
+    for (int r=0; r+1<rows; ++r) {
+        for (int c=0; c+1<cols; ++c) {
+            if (unit(rng)>=0.05) continue;
+            int u=r*cols+c;
+            int a=rng()%2 ? u : u+1,b=a==u ? u+cols+1 : u+cols;
+            if (degree[a]<4 && degree[b]<4) link(a,b,slow(rng));
+        }
+    }
+    // added by lower endpoint, the order saveCSV writes and loadFromCSV
+    // reads them in, so the CSV form rebuilds exactly the same CSR
+    sort(roads.begin(),roads.end(),[](const Edge& a,const Edge& b) { return a.u!=b.u ? a.u<b.u : a.v<b.v; });
+    for (const Edge& e:roads) g.addEdge(e.u,e.v,e.weight);
+    g.buildCSR();
+    g.buildDSU();
+}
+bool generateGraph(Graph& g,const string& shape,int n,unsigned seed) {
+    if (shape=="grid") {
+        int rows=max(1,(int)ceil(sqrt((double)max(n,1))));
+        generateGrid(g,rows,max(1,(n+rows-1)/rows),seed);
+    } else if (shape=="geometric") {
+        generateGeometric(g,n,seed);
+    } else if (shape=="road") {
+        generateRoadLike(g,n,seed);
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,121 @@
+#include "../include/graph.h"
+#include "../include/algorithms.h"
+#include "../include/csv_reader.h"
+#include <algorithm>
+#include <iostream>
+using namespace std;
+// Shared tail of the importers: nodes[k] gets id k, arcs are 0-based
+bool Graph::finishImport(vector<Attraction>& nodes,vector<Edge>& arcs) {
+    // one road per pair: orient every arc u<v, then keep the cheapest
+    for (Edge& e:arcs) if (e.u>e.v) swap(e.u,e.v);
+    sort(arcs.begin(),arcs.end(),[](const Edge& a,const Edge& b) {
+        if (a.u!=b.u) return a.u<b.u;
+        if (a.v!=b.v) return a.v<b.v;
+        return a.weight<b.weight;
+    });
+    arcs.erase(unique(arcs.begin(),arcs.end(),[](const Edge& a,const Edge& b) { return a.u==b.u && a.v==b.v; }),
+               arcs.end());
+    attractions.reserve(nodes.size());
+    adjList.reserve(nodes.size());
+    for (Attraction& a:nodes) addAttraction(a);
+    for (const Edge& e:arcs) addEdge(e.u,e.v,e.weight);
+    buildCSR();
+    buildDSU();
+    return true;
+}
+bool Graph::loadFromDIMACS(const string& grFile,const string& coFile) {
+    clearAll();
+    CsvReader in(' ');
+    auto fail=[&](const string& file,const string& what) {
+        cerr<<"[graph] "<<file<<":"<<in.lineNumber()<<": "<<what<<"\n";
+        clearAll();
+        return false;
+    };
+    if (!in.open(grFile)) {
+        cerr<<"[graph] cannot open DIMACS graph: "<<grFile<<"\n";
+        return false;
+    }
+    int n=-1;
+    vector<Edge> arcs;
+    while (in.next()) {
+        string_view tag=in.field(0);
+        if (tag=="c") continue;
+        if (tag=="p") {
+            int m=0;
+            if (in.fieldCount()<4 || in.field(1)!="sp" || !in.number(2,n) || !in.number(3,m) || n<0 || m<0)
+                return fail(grFile,"expected \"p sp <nodes> <arcs>\"");
+            arcs.reserve(m);
+        } else if (tag=="a") {
+            if (n<0) return fail(grFile,"arc before the \"p sp\" line");
+            Edge e;
+            if (in.fieldCount()<4 || !in.number(1,e.u) || !in.number(2,e.v) || !in.number(3,e.weight))
+                return fail(grFile,"expected \"a <from> <to> <weight>\"");
+            if (e.u<1 || e.u>n || e.v<1 || e.v>n) return fail(grFile,"node id out of range");
+            if (e.weight<0) return fail(grFile,"negative arc weight");
+            --e.u; --e.v;
+            arcs.push_back(e);
+        } else {
+            return fail(grFile,"unknown line type \""+string(tag)+"\"");
+        }
+    }
+    if (n<0) return fail(grFile,"no \"p sp\" line");
+    vector<Attraction> nodes(n);
+    for (int k=0; k<n; ++k) {
+        nodes[k].id=k;
+        nodes[k].name="v"+to_string(k+1);
+    }
+    if (!coFile.empty()) {
+        if (!in.open(coFile)) {
+            cerr<<"[graph] cannot open DIMACS coordinates: "<<coFile<<"\n";
+            clearAll();
+            return false;
+        }
+        while (in.next()) {
+            string_view tag=in.field(0);
+            if (tag=="c" || tag=="p") continue;
+            int k=0;
+            double x=0,y=0;
+            if (tag!="v" || in.fieldCount()<4 || !in.number(1,k) || !in.number(2,x) || !in.number(3,y))
+                return fail(coFile,"expected \"v <id> <x> <y>\"");
+            if (k<1 || k>n) return fail(coFile,"node id out of range");
+            nodes[k-1].longitude=x/1e6;
+            nodes[k-1].latitude=y/1e6;
+        }
+    }
+    return finishImport(nodes,arcs);
+}
+bool Graph::loadFromEdgeList(const string& file) {
+    clearAll();
+    CsvReader in(' ');
+    if (!in.open(file)) {
+        cerr<<"[graph] cannot open edge list: "<<file<<"\n";
+        return false;
+    }
+    vector<Edge> arcs;
+    while (in.next()) {
+        char first=in.field(0)[0];
+        if (first=='#' || first=='%') continue;
+        Edge e;
+        e.weight=1;
+        if (in.fieldCount()<2 || !in.number(0,e.u) || !in.number(1,e.v) || !in.number(2,e.weight) ||
+            e.u<0 || e.v<0 || e.weight<0) {
+            cerr<<"[graph] "<<file<<":"<<in.lineNumber()<<": expected \"<from> <to> [weight]\"\n";
+            return false;
+        }
+        arcs.push_back(e);
+    }
+    // renumber the ids that occur densely, keeping their order
+    vector<int> ids;
+    ids.reserve(2*arcs.size());
+    for (const Edge& e:arcs) { ids.push_back(e.u); ids.push_back(e.v); }
+    sort(ids.begin(),ids.end());
+    ids.erase(unique(ids.begin(),ids.end()),ids.end());
+    auto dense=[&](int id) { return (int)(lower_bound(ids.begin(),ids.end(),id)-ids.begin()); };
+    for (Edge& e:arcs) { e.u=dense(e.u); e.v=dense(e.v); }
+    vector<Attraction> nodes(ids.size());
+    for (size_t k=0; k<ids.size(); ++k) {
+        nodes[k].id=(int)k;
+        nodes[k].name="v"+to_string(ids[k]);
+    }
+    return finishImport(nodes,arcs);
+}
@@ -0,0 +1,136 @@
+#include "../include/landmarks.h"
+#include "../include/algorithms.h"
+#include "../include/graph.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+using namespace std;
+static const double LM_INF=numeric_limits<double>::infinity();
+// lower bound on d(a,b) from the landmark columns chosen so far
+static double columnsBound(const vector<vector<double>>& cols,int a,int b) {
+    double best=0;
+    for (auto& d:cols) {
+        if (d[a]==LM_INF || d[b]==LM_INF) continue;
+        best=max(best,fabs(d[a]-d[b]));
+    }
+    return best;
+}
+// valid vertex maximising the distance to its nearest chosen landmark;
+// vertices no landmark reaches count as infinitely far (new component)
+static int farthestVertex(const vector<vector<double>>& cols,const vector<int>& candidates) {
+    int best=-1; double bestD=-1;
+    for (int v:candidates) {
+        double m=LM_INF;
+        for (auto& d:cols) m=min(m,d[v]);
+        if (m>bestD) { bestD=m; best=v; }
+    }
+    return bestD>0 ? best : -1;
+}
+// Goldberg & Werneck's "avoid": grow a shortest-path tree from a random root,
+// weight each vertex by how badly the current bounds estimate its distance,
+// and descend into the heaviest subtree that holds no landmark yet.
+static int avoidVertex(const Graph& g,const vector<vector<double>>& cols,
+                       const vector<int>& candidates,const vector<bool>& isLandmark,mt19937& rng) {
+    int root=candidates[rng()%candidates.size()];
+    auto tree=dijkstraWithPath(g,root);
+    const vector<double>& d=tree.first;
+    const vector<int>& parent=tree.second;
+    int n=(int)d.size();
+    vector<vector<int>> children(n);
+    for (int v=0; v<n; ++v) if (parent[v]!=-1) children[parent[v]].push_back(v);
+    // BFS order from the root so children always come after their parent
+    vector<int> order;
+    order.push_back(root);
+    for (size_t i=0; i<order.size(); ++i)
+        for (int c:children[order[i]]) order.push_back(c);
+    vector<double> size(n,0);
+    vector<bool> hasLandmark(n,false);
+    for (int i=(int)order.size()-1; i>=0; --i) {
+        int v=order[i];
+        hasLandmark[v]=isLandmark[v];
+        double s=d[v]-columnsBound(cols,root,v);
+        for (int c:children[v]) {
+            if (hasLandmark[c]) hasLandmark[v]=true;
+            s+=size[c];
+        }
+        size[v]=hasLandmark[v] ? 0 : s;
+    }
+    int w=-1; double bestSize=0;
+    for (int v:order) if (size[v]>bestSize) { bestSize=size[v]; w=v; }
+    if (w==-1) return -1;
+    while (true) {
+        int next=-1; double nextSize=0;
+        for (int c:children[w]) if (size[c]>nextSize) { nextSize=size[c]; next=c; }
+        if (next==-1) break;
+        w=next;
+    }
+    return w;
+}
+void LandmarkIndex::build(const Graph& g,int count,LandmarkSelection selection,unsigned seed) {
+    n=g.csr().numNodes;
+    k=0;
+    landmarks.clear();
+    dist.clear();
+    if (n<=0 || count<=0) return;
+    vector<int> candidates;
+    for (int v=0; v<n; ++v) if (g.isValidAttraction(v)) candidates.push_back(v);
+    if (candidates.empty()) return;
+    mt19937 rng(seed);
+    vector<vector<double>> cols;
+    vector<bool> isLandmark(n,false);
+    auto add=[&](int l) {
+        landmarks.push_back(l);
+        isLandmark[l]=true;
+        cols.push_back(dijkstra(g,l));
+    };
+    // seed: the vertex farthest from a random start is a good first landmark
+    {
+        int r=candidates[rng()%candidates.size()];
+        vector<double> d=dijkstra(g,r);
+        int first=r; double far=0;
+        for (int v:candidates) if (d[v]!=LM_INF && d[v]>far) { far=d[v]; first=v; }
+        add(first);
+    }
+    while ((int)landmarks.size()<count && landmarks.size()<candidates.size()) {
+        int next=-1;
+        // an unreached component always gets a landmark first
+        for (int v:candidates) {
+            bool reached=false;
+            for (auto& d:cols) if (d[v]!=LM_INF) { reached=true; break; }
+            if (!reached) { next=v; break; }
+        }
+        if (next==-1 && selection==LandmarkSelection::Avoid) next=avoidVertex(g,cols,candidates,isLandmark,rng);
+        if (next==-1 || isLandmark[next]) next=farthestVertex(cols,candidates);
+        if (next==-1 || isLandmark[next]) break;
+        add(next);
+    }
+    // pack vertex-major floats, rounded toward zero so bounds stay admissible
+    k=(int)landmarks.size();
+    dist.assign((size_t)n*k,numeric_limits<float>::infinity());
+    for (int i=0; i<k; ++i) {
+        for (int v=0; v<n; ++v) {
+            double d=cols[i][v];
+            if (d==LM_INF) continue;
+            float f=(float)d;
+            if ((double)f>d) f=nextafter(f,0.0f);
+            dist[(size_t)v*k+i]=f;
+        }
+    }
+}
+double LandmarkIndex::lowerBound(int v,int t) const {
+    if (k==0 || v<0 || t<0 || v>=n || t>=n) return 0;
+    const float* dv=&dist[(size_t)v*k];
+    const float* dt=&dist[(size_t)t*k];
+    double best=0;
+    for (int i=0; i<k; ++i) {
+        if (dv[i]==numeric_limits<float>::infinity() || dt[i]==numeric_limits<float>::infinity()) continue;
+        // both values were rounded down by up to one float ulp, so give that back
+        double hi=max(dv[i],dt[i]);
+        double diff=fabs((double)dv[i]-(double)dt[i])-hi*FLT_EPSILON;
+        if (diff>best) best=diff;
+    }
+    return best;
+}
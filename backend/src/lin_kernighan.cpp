@@ -0,0 +1,243 @@
+#include "../include/algorithms.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+using namespace std;
+static const double LK_EPS=1e-9;
+vector<vector<int>> alphaNearnessCandidates(const DistanceMatrix& dist,int k) {
+    // alpha(i,j) = d(i,j) - (heaviest MST edge on the tree path i..j): how much
+    // forcing edge (i,j) into the MST would cost. Good tour edges have small alpha.
+    int n=(int)dist.size();
+    vector<vector<int>> cands(n);
+    if (n<2) return cands;
+    vector<Edge> edges;
+    for (int i=0; i<n; ++i)
+        for (int j=i+1; j<n; ++j) edges.push_back({i,j,dist[i][j]});
+    vector<Edge> mst=kruskalMST(edges,n);
+    vector<vector<pair<int,double>>> tree(n);
+    for (const Edge& e:mst) { tree[e.u].push_back({e.v,e.weight}); tree[e.v].push_back({e.u,e.weight}); }
+    vector<double> beta(n);
+    vector<int> stack,order(n);
+    vector<char> seen(n);
+    for (int i=0; i<n; ++i) {
+        // beta[j] = heaviest edge on the tree path i..j, one DFS per root
+        fill(seen.begin(),seen.end(),0);
+        beta[i]=-numeric_limits<double>::infinity();
+        seen[i]=1;
+        stack.assign(1,i);
+        while (!stack.empty()) {
+            int u=stack.back(); stack.pop_back();
+            for (auto& e:tree[u]) {
+                if (seen[e.first]) continue;
+                seen[e.first]=1;
+                beta[e.first]=max(beta[u],e.second);
+                stack.push_back(e.first);
+            }
+        }
+        order.resize(n);
+        for (int j=0; j<n; ++j) order[j]=j;
+        order.erase(order.begin()+i);
+        int keep=min(k,(int)order.size());
+        auto alpha=[&](int j) { return seen[j] ? dist[i][j]-beta[j] : dist[i][j]; };
+        partial_sort(order.begin(),order.begin()+keep,order.end(),[&](int x,int y) {
+            double ax=alpha(x),ay=alpha(y);
+            if (ax!=ay) return ax<ay;
+            if (dist[i][x]!=dist[i][y]) return dist[i][x]<dist[i][y];
+            return x<y;
+        });
+        cands[i].assign(order.begin(),order.begin()+keep);
+        // LK stops scanning once a candidate is too far, so keep them by distance
+        sort(cands[i].begin(),cands[i].end(),[&](int x,int y) {
+            return dist[i][x]<dist[i][y] || (dist[i][x]==dist[i][y] && x<y);
+        });
+    }
+    return cands;
+}
+namespace {
+// The open path 0 -> ... -> last becomes a cycle through a dummy stop D that
+// is free to reach from anywhere. The edge D-0 pins the start: it is never
+// removed, and c[0] = 0, c[N-1] = D stay put because 2-opt moves only ever
+// reverse c[p+1..q] with q < N-1.
+struct LKTour {
+    const DistanceMatrix& dist;
+    const vector<vector<int>>& cands;
+    int n,N,D;
+    vector<int> c,pos;
+    vector<pair<int,int>> applied;   // reversed ranges of the current chain, for undo
+    LKTour(const DistanceMatrix& dist,const vector<vector<int>>& cands)
+        :dist(dist),cands(cands),n((int)dist.size()),N(n+1),D(n),c(N),pos(N) {}
+    void load(const vector<int>& path) {
+        for (int p=0; p<n; ++p) c[p]=path[p];
+        c[n]=D;
+        for (int p=0; p<N; ++p) pos[c[p]]=p;
+    }
+    void store(vector<int>& path) const { path.assign(c.begin(),c.begin()+n); }
+    double d(int a,int b) const { return (a==D || b==D) ? 0 : dist[a][b]; }
+    int succ(int x) const { return c[(pos[x]+1)%N]; }
+    int pred(int x) const { return c[(pos[x]+N-1)%N]; }
+    bool pinned(int a,int b) const { return (a==D && b==0) || (a==0 && b==D); }
+    // position of the first endpoint of tour edge (a,b)
+    int left(int a,int b) const {
+        int pa=pos[a],pb=pos[b];
+        if ((pa+1)%N==pb) return pa;
+        return pb;
+    }
+    static bool same(int a,int b,int x,int y) { return (a==x && b==y) || (a==y && b==x); }
+    // can tour edges (t1,t2),(t3,t4) be swapped for (t2,t3),(t4,t1) by one reversal?
+    bool valid(int t1,int t2,int t3,int t4,int& p,int& q) const {
+        p=left(t1,t2); q=left(t3,t4);
+        if (p==q) return false;
+        if (p>q) swap(p,q);
+        if (q>=N-1) return false;   // only the pinned edge sits at N-1
+        int a=c[p],b=c[p+1],x=c[q],y=c[q+1];
+        return (same(a,x,t2,t3) && same(b,y,t4,t1)) || (same(a,x,t4,t1) && same(b,y,t2,t3));
+    }
+    void reverseRange(int p,int q) {
+        reverse(c.begin()+p+1,c.begin()+q+1);
+        for (int i=p+1; i<=q; ++i) pos[c[i]]=i;
+    }
+    void undoTo(size_t keep) {
+        while (applied.size()>keep) {
+            reverseRange(applied.back().first,applied.back().second);
+            applied.pop_back();
+        }
+    }
+    // One LK chain from t1: remove (t1,t2), then repeatedly add (t2,t3),
+    // remove (t3,t4) and keep (t4,t1) as the closing edge; every step is one
+    // 2-opt reversal. Breadth at the first level, greedy below, keeping the
+    // best closed prefix. Returns the gain (0 if nothing improved).
+    double improveFrom(int t1,int maxDepth,vector<int>& touched) {
+        for (int dir=0; dir<2; ++dir) {
+            int t2=dir==0 ? succ(t1) : pred(t1);
+            if (t2==D) continue;   // D has no candidates to continue from
+            double g0=d(t1,t2);
+            for (int t3:cands[t2]) {
+                double g1=g0-d(t2,t3);
+                if (g1<=LK_EPS) break;
+                if (t3==t1 || t3==succ(t2) || t3==pred(t2)) continue;
+                applied.clear();
+                vector<pair<int,int>> added={{t2,t3}},removed={{t1,t2}};
+                double best=0,g=g1;
+                size_t bestLen=0;
+                int cur2=t2,cur3=t3;
+                vector<int> chain={t1,t2};
+                for (int depth=0; depth<maxDepth; ++depth) {
+                    // close with whichever neighbor of t3 keeps a single cycle
+                    int t4=-1,p=0,q=0;
+                    for (int cand4:{succ(cur3),pred(cur3)}) {
+                        if (cand4==cur2 || cand4==t1 || pinned(cur3,cand4)) continue;
+                        bool tabu=false;
+                        for (auto& e:added) if (same(e.first,e.second,cur3,cand4)) tabu=true;
+                        if (tabu) continue;
+                        if (valid(t1,cur2,cur3,cand4,p,q)) { t4=cand4; break; }
+                    }
+                    if (t4==-1) break;
+                    reverseRange(p,q);
+                    applied.push_back({p,q});
+                    removed.push_back({cur3,t4});
+                    chain.push_back(cur3); chain.push_back(t4);
+                    g+=d(cur3,t4);
+                    double closed=g-d(t4,t1);
+                    if (closed>best+LK_EPS) { best=closed; bestLen=applied.size(); }
+                    if (t4==D) break;
+                    // greedy next step from t4: best g - d(t4,t5) + d(t5,t6)
+                    int next3=-1; double nextScore=-numeric_limits<double>::infinity();
+                    for (int t5:cands[t4]) {
+                        double gi=g-d(t4,t5);
+                        if (gi<=LK_EPS) break;
+                        if (t5==t1 || t5==succ(t4) || t5==pred(t4)) continue;
+                        bool tabu=false;
+                        for (auto& e:removed) if (same(e.first,e.second,t4,t5)) tabu=true;
+                        if (tabu) continue;
+                        double score=gi+max(d(t5,succ(t5)),d(t5,pred(t5)));
+                        if (score>nextScore) { nextScore=score; next3=t5; }
+                    }
+                    if (next3==-1) break;
+                    g-=d(t4,next3);
+                    added.push_back({t4,next3});
+                    cur2=t4; cur3=next3;
+                }
+                undoTo(bestLen);
+                if (best>LK_EPS) {
+                    chain.resize(min(chain.size(),2+2*bestLen));
+                    for (int v:chain) if (v!=D) touched.push_back(v);
+                    return best;
+                }
+            }
+        }
+        return 0;
+    }
+};
+// LK passes with don't-look bits until no chain improves, returns the total gain
+double lkOptimize(LKTour& T,vector<int>& active,int maxDepth) {
+    vector<char> queued(T.n,0);
+    for (int v:active) queued[v]=1;
+    double total=0;
+    vector<int> touched;
+    for (size_t h=0; h<active.size(); ++h) {
+        int a=active[h];
+        queued[a]=0;
+        touched.clear();
+        double gain=T.improveFrom(a,maxDepth,touched);
+        if (gain<=0) continue;
+        total+=gain;
+        touched.push_back(a);
+        for (int v:touched) if (!queued[v]) { queued[v]=1; active.push_back(v); }
+    }
+    active.clear();
+    return total;
+}
+// Double bridge on the open path, keeping stop 0 first:
+// 0..A | B | C | D  ->  0..A | C | B | D
+vector<int> doubleBridge(const vector<int>& path,mt19937& rng,vector<int>& kicked) {
+    int n=(int)path.size();
+    vector<int> cut={1+(int)(rng()%(n-1)),1+(int)(rng()%(n-1)),1+(int)(rng()%(n-1))};
+    sort(cut.begin(),cut.end());
+    vector<int> out(path.begin(),path.begin()+cut[0]);
+    out.insert(out.end(),path.begin()+cut[1],path.begin()+cut[2]);
+    out.insert(out.end(),path.begin()+cut[0],path.begin()+cut[1]);
+    out.insert(out.end(),path.begin()+cut[2],path.end());
+    kicked.clear();
+    for (int x:cut) {
+        kicked.push_back(path[x-1]);
+        kicked.push_back(path[x]);
+    }
+    return out;
+}
+}
+pair<double,vector<int>> tspLinKernighan(const DistanceMatrix& dist,const LinKernighanOptions& opts) {
+    int n=(int)dist.size();
+    if (n<=3) return tspDP(dist);
+    auto deadline=chrono::steady_clock::now()+chrono::milliseconds(max(0,opts.timeLimitMs));
+    vector<vector<int>> cands=opts.alphaNearness ? alphaNearnessCandidates(dist,opts.candidates)
+                                                 : nearestNeighbors(dist,opts.candidates);
+    vector<vector<int>> orNbrs=nearestNeighbors(dist,opts.candidates);
+    LKTour T(dist,cands);
+    // start from the MST tour after the cheap local search stages
+    vector<int> path=tspMSTApproximation(dist).second;
+    vector<int> active(path.begin(),path.end());
+    auto descend=[&](vector<int>& p,vector<int>& act) {
+        T.load(p);
+        bool more=true;
+        while (more) {
+            lkOptimize(T,act,opts.maxDepth);
+            T.store(p);
+            more=localSearchStage(p,dist,orNbrs,TourMove::OrOpt);
+            if (more) { T.load(p); act.assign(p.begin(),p.end()); }
+        }
+    };
+    descend(path,active);
+    double best=tourLength(path,dist);
+    mt19937 rng(opts.seed);
+    vector<int> kicked;
+    for (int kick=0; opts.maxKicks<0 || kick<opts.maxKicks; ++kick) {
+        if (chrono::steady_clock::now()>=deadline) break;
+        vector<int> trial=doubleBridge(path,rng,kicked);
+        descend(trial,kicked);
+        double len=tourLength(trial,dist);
+        if (len+LK_EPS<best) { best=len; path.swap(trial); }
+    }
+    return {best,path};
+}
@@ -0,0 +1,175 @@
+#include "../include/algorithms.h"
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <vector>
+using namespace std;
+// Tours here are open paths: tour[0] is the fixed start and the last stop
+// simply ends the day. Edge p joins positions p and p+1; the "edge" after
+// the last position is virtual and costs nothing, so every move below treats
+// p == n-1 as a free connection to the end of the route.
+static const double GAIN_EPS=1e-9;
+vector<vector<int>> nearestNeighbors(const DistanceMatrix& dist,int k) {
+    int n=(int)dist.size();
+    vector<vector<int>> nbrs(n);
+    vector<int> order;
+    for (int a=0; a<n; ++a) {
+        order.resize(n);
+        iota(order.begin(),order.end(),0);
+        order.erase(order.begin()+a);
+        int keep=min(k,(int)order.size());
+        partial_sort(order.begin(),order.begin()+keep,order.end(),[&](int x,int y) {
+            return dist[a][x]<dist[a][y] || (dist[a][x]==dist[a][y] && x<y);
+        });
+        nbrs[a].assign(order.begin(),order.begin()+keep);
+    }
+    return nbrs;
+}
+namespace {
+struct OpenTour {
+    vector<int>& t;
+    const DistanceMatrix& d;
+    const vector<vector<int>>& nbrs;
+    int n;
+    vector<int> pos;
+    vector<int> touched;   // stops whose neighborhood changed in the last move
+    OpenTour(vector<int>& t,const DistanceMatrix& d,const vector<vector<int>>& nbrs)
+        :t(t),d(d),nbrs(nbrs),n((int)t.size()),pos(d.size()) { reindex(0,n-1); }
+    void reindex(int from,int to) { for (int p=from; p<=to; ++p) pos[t[p]]=p; }
+    // cost of edge p (positions p,p+1), 0 for the virtual edge after the end
+    double edge(int p) const { return p>=n-1 ? 0 : d[t[p]][t[p+1]]; }
+    // cost of joining stop a to whatever sits at position p (0 past the end)
+    double link(int a,int p) const { return p>=n ? 0 : d[a][t[p]]; }
+    void touch(int p) { if (p>=0 && p<n) touched.push_back(t[p]); }
+
+    // 2-opt(p,q), p<q: drop edges p and q, reverse positions p+1..q
+    double twoOptGain(int p,int q) const {
+        return edge(p)+edge(q)-d[t[p]][t[q]]-link(t[p+1],q+1);
+    }
+    void applyTwoOpt(int p,int q) {
+        reverse(t.begin()+p+1,t.begin()+q+1);
+        reindex(p+1,q);
+        touch(p); touch(p+1); touch(q); touch(q+1);
+    }
+};
+// Every 2-opt move that creates the edge (a,c): dropping the edges after a
+// and c, or the edges before them.
+bool twoOptMove(OpenTour& T,int a) {
+    int i=T.pos[a];
+    double around=max(T.edge(i),i>0 ? T.edge(i-1) : 0.0);
+    for (int c:T.nbrs[a]) {
+        if (T.d[a][c]+GAIN_EPS>=around) break;
+        int j=T.pos[c];
+        int p=min(i,j),q=max(i,j);
+        if (q-p>=2 && T.twoOptGain(p,q)>GAIN_EPS) { T.applyTwoOpt(p,q); return true; }
+        if (p>=1 && q-p>=2 && T.twoOptGain(p-1,q-1)>GAIN_EPS) { T.applyTwoOpt(p-1,q-1); return true; }
+    }
+    return false;
+}
+// Or-opt: move a run of 1-3 stops that starts or ends at a next to one of a's
+// neighbors, in either orientation.
+bool orOptMove(OpenTour& T,int a) {
+    int i=T.pos[a];
+    if (i==0) return false;
+    for (int len=1; len<=3; ++len) {
+        for (int s:{i,i-len+1}) {
+            int e=s+len-1;
+            if (s<1 || e>=T.n || (len==1 && s!=i)) continue;
+            int first=T.t[s],last=T.t[e];
+            double removeGain=T.edge(s-1)+T.edge(e)-T.link(T.t[s-1],e+1);
+            if (removeGain<=GAIN_EPS) continue;
+            for (int c:T.nbrs[a]) {
+                if (T.d[a][c]+GAIN_EPS>=removeGain) break;
+                int j=T.pos[c];
+                if (j>=s-1 && j<=e) continue;
+                // insert between positions p and p+1, next to c on either side
+                for (int p:{j-1,j}) {
+                    if (p<0 || (p>=s-1 && p<=e)) continue;
+                    double base=T.edge(p);
+                    double fwd=T.d[T.t[p]][first]+T.link(last,p+1);
+                    double rev=T.d[T.t[p]][last]+T.link(first,p+1);
+                    bool reversed=rev<fwd;
+                    double gain=removeGain+base-min(fwd,rev);
+                    if (gain<=GAIN_EPS) continue;
+                    int lo,hi;
+                    if (p>e) {
+                        rotate(T.t.begin()+s,T.t.begin()+e+1,T.t.begin()+p+1);
+                        lo=p-len+1; hi=p;
+                        T.reindex(s,p);
+                        T.touch(s-1); T.touch(s);
+                    } else {
+                        rotate(T.t.begin()+p+1,T.t.begin()+s,T.t.begin()+e+1);
+                        lo=p+1; hi=p+len;
+                        T.reindex(p+1,e);
+                        T.touch(e); T.touch(e+1);
+                    }
+                    if (reversed) { reverse(T.t.begin()+lo,T.t.begin()+hi+1); T.reindex(lo,hi); }
+                    T.touch(lo-1); T.touch(lo); T.touch(hi); T.touch(hi+1);
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+// Pure 3-opt segment exchange (no reversal): with edges i<j<k dropped,
+//   t[i] -> t[j+1..k] -> t[i+1..j] -> t[k+1]
+// Sequential search: (t[i], t[j+1]) from a's neighbors, then
+// (t[k], t[i+1]) from t[i+1]'s neighbors, each partial gain kept positive.
+bool threeOptMove(OpenTour& T,int a) {
+    int i=T.pos[a];
+    if (i>=T.n-2) return false;
+    int b=T.t[i+1];
+    for (int c:T.nbrs[a]) {
+        double g1=T.edge(i)-T.d[a][c];
+        if (g1<=GAIN_EPS) break;
+        int j=T.pos[c]-1;
+        if (j<=i) continue;
+        for (int e:T.nbrs[b]) {
+            double g2=g1+T.edge(j)-T.d[e][b];
+            if (g2<=GAIN_EPS) break;
+            int k=T.pos[e];
+            if (k<=j) continue;
+            double gain=g2+T.edge(k)-T.link(T.t[j],k+1);
+            if (gain<=GAIN_EPS) continue;
+            rotate(T.t.begin()+i+1,T.t.begin()+j+1,T.t.begin()+k+1);
+            T.reindex(i+1,k);
+            T.touch(i); T.touch(i+1); T.touch(k-(j-i)); T.touch(k-(j-i)+1); T.touch(k); T.touch(k+1);
+            return true;
+        }
+    }
+    return false;
+}
+}
+bool localSearchStage(vector<int>& tour,const DistanceMatrix& dist,const vector<vector<int>>& nbrs,TourMove move) {
+    int n=(int)tour.size();
+    if (n<3) return false;
+    OpenTour T(tour,dist,nbrs);
+    bool (*step)(OpenTour&,int)=move==TourMove::TwoOpt ? twoOptMove
+                               : move==TourMove::OrOpt ? orOptMove : threeOptMove;
+    // don't-look bits: a stop is only re-examined after a move changed one
+    // of its tour edges
+    deque<int> active(tour.begin(),tour.end());
+    vector<char> queued(dist.size(),1);
+    bool improved=false;
+    while (!active.empty()) {
+        int a=active.front(); active.pop_front();
+        queued[a]=0;
+        T.touched.clear();
+        if (!step(T,a)) continue;
+        improved=true;
+        T.touched.push_back(a);
+        for (int v:T.touched) if (!queued[v]) { queued[v]=1; active.push_back(v); }
+    }
+    return improved;
+}
+void localSearch(vector<int>& tour,const DistanceMatrix& dist,const vector<TourMove>& pipeline,int neighbors) {
+    if (tour.size()<3) return;
+    vector<vector<int>> nbrs=nearestNeighbors(dist,neighbors);
+    // rerun the pipeline until a full round leaves the tour alone
+    bool improved=true;
+    while (improved) {
+        improved=false;
+        for (TourMove m:pipeline) if (localSearchStage(tour,dist,nbrs,m)) improved=true;
+    }
+}
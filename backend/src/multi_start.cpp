@@ -0,0 +1,92 @@
+#include "../include/algorithms.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+using namespace std;
+namespace {
+// A cyclic order that may start anywhere, as an open path from stop 0:
+// rotate 0 to the front and walk whichever direction is shorter
+vector<int> openAtZero(const vector<int>& cycle,const DistanceMatrix& dist) {
+    int n=(int)cycle.size();
+    int z=(int)(find(cycle.begin(),cycle.end(),0)-cycle.begin());
+    vector<int> fwd(n),bwd(n);
+    for (int i=0; i<n; ++i) {
+        fwd[i]=cycle[(z+i)%n];
+        bwd[i]=cycle[(z-i+n)%n];
+    }
+    return tourLength(bwd,dist)<tourLength(fwd,dist) ? bwd : fwd;
+}
+vector<int> greedyFrom(const DistanceMatrix& dist,int s) {
+    int n=(int)dist.size();
+    vector<char> used(n,0);
+    vector<int> order={s};
+    used[s]=1;
+    for (int cur=s; (int)order.size()<n; ) {
+        int nxt=-1;
+        for (int i=0; i<n; ++i)
+            if (!used[i] && (nxt==-1 || dist[cur][i]<dist[cur][nxt])) nxt=i;
+        used[nxt]=1; order.push_back(nxt); cur=nxt;
+    }
+    return order;
+}
+// cheapest insertion of the stops in random order into the open path [0]
+vector<int> randomInsertion(const DistanceMatrix& dist,mt19937& rng) {
+    int n=(int)dist.size();
+    vector<int> rest(n-1);
+    iota(rest.begin(),rest.end(),1);
+    shuffle(rest.begin(),rest.end(),rng);
+    vector<int> path={0};
+    for (int x:rest) {
+        // after position p; appending past the end only pays the new edge
+        int at=(int)path.size()-1;
+        double best=dist[path.back()][x];
+        for (int p=0; p+1<(int)path.size(); ++p) {
+            double c=dist[path[p]][x]+dist[x][path[p+1]]-dist[path[p]][path[p+1]];
+            if (c<best) { best=c; at=p; }
+        }
+        path.insert(path.begin()+at+1,x);
+    }
+    return path;
+}
+}
+pair<double,vector<int>> tspMultiStart(const DistanceMatrix& dist,const MultiStartOptions& opts,ThreadPool& pool) {
+    int n=(int)dist.size();
+    if (n<=3) return tspDP(dist);
+    int starts=max(1,opts.starts);
+    vector<Edge> edges;
+    for (int i=0; i<n; ++i)
+        for (int j=i+1; j<n; ++j) edges.push_back({i,j,dist[i][j]});
+    vector<Edge> mst=kruskalMST(edges,n);
+    vector<vector<int>> nbrs=nearestNeighbors(dist,10);
+    vector<vector<int>> tours(starts);
+    vector<double> lengths(starts);
+    // start t only depends on (seed, t), never on which thread runs it
+    pool.parallelFor(starts,[&](int t) {
+        mt19937 rng(opts.seed*2654435761u+(unsigned)t);
+        int root=t<3 ? 0 : (int)(rng()%n);
+        vector<int> tour;
+        switch (t%3) {
+        case 0: tour=openAtZero(mstToTour(mst,n,root),dist); break;
+        case 1: tour=openAtZero(greedyFrom(dist,root),dist); break;
+        default: tour=randomInsertion(dist,rng); break;
+        }
+        bool improved=true;
+        while (improved) {
+            improved=false;
+            for (TourMove m:{TourMove::TwoOpt,TourMove::OrOpt,TourMove::ThreeOpt})
+                if (localSearchStage(tour,dist,nbrs,m)) improved=true;
+        }
+        lengths[t]=tourLength(tour,dist);
+        tours[t].swap(tour);
+    });
+    // lowest index wins ties, so the pick is as deterministic as the starts
+    int best=0;
+    for (int t=1; t<starts; ++t) if (lengths[t]+1e-9<lengths[best]) best=t;
+    return {lengths[best],tours[best]};
+}
+pair<double,vector<int>> tspMultiStart(const DistanceMatrix& dist,const MultiStartOptions& opts) {
+    return tspMultiStart(dist,opts,ThreadPool::shared());
+}
@@ -0,0 +1,133 @@
+#include "../include/algorithms.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+using namespace std;
+namespace {
+const double OP_EPS=1e-9;
+struct Instance {
+    const DistanceMatrix& d;
+    const vector<double>& service;
+    const vector<double>& prize;
+    const vector<double>& fee;
+    double timeBudget,feeBudget;
+};
+// extra time for putting x right after route[p] (past the end: only the new edge)
+double insertCost(const Instance& I,const vector<int>& route,int p,int x) {
+    double c=I.d[route[p]][x]+I.service[x];
+    if (p+1<(int)route.size()) c+=I.d[x][route[p+1]]-I.d[route[p]][route[p+1]];
+    return c;
+}
+// cheapest position for x, {-1, inf} if the route has no room for it
+pair<int,double> bestInsert(const Instance& I,const vector<int>& route,double time,int x) {
+    int at=-1; double best=numeric_limits<double>::infinity();
+    for (int p=0; p<(int)route.size(); ++p) {
+        double c=insertCost(I,route,p,x);
+        if (c<best) { best=c; at=p; }
+    }
+    if (time+best>I.timeBudget+OP_EPS) return {-1,best};
+    return {at,best};
+}
+double routeTime(const Instance& I,const vector<int>& route) {
+    double t=0;
+    for (size_t i=0; i<route.size(); ++i) {
+        t+=I.service[route[i]];
+        if (i+1<route.size()) t+=I.d[route[i]][route[i+1]];
+    }
+    return t;
+}
+struct State {
+    vector<int> route;
+    vector<char> in;
+    double time=0,fees=0,prize=0;
+    void add(const Instance& I,int x,int after,double cost) {
+        route.insert(route.begin()+after+1,x);
+        in[x]=1; time+=cost; fees+=I.fee[x]; prize+=I.prize[x];
+    }
+};
+// repeatedly insert the stop with the best prize per extra minute
+bool fill(const Instance& I,State& s) {
+    int n=(int)I.d.size();
+    bool any=false;
+    while (true) {
+        int pick=-1,at=-1; double pickCost=0,bestRatio=-1;
+        for (int x=0; x<n; ++x) {
+            if (s.in[x] || I.prize[x]<=0 || s.fees+I.fee[x]>I.feeBudget+OP_EPS) continue;
+            auto ins=bestInsert(I,s.route,s.time,x);
+            if (ins.first<0) continue;
+            double ratio=I.prize[x]/max(ins.second,OP_EPS);
+            if (ratio>bestRatio) { bestRatio=ratio; pick=x; at=ins.first; pickCost=ins.second; }
+        }
+        if (pick<0) return any;
+        s.add(I,pick,at,pickCost);
+        any=true;
+    }
+}
+// reorder the chosen stops (start stays first) to free up time
+bool shorten(const Instance& I,State& s) {
+    int k=(int)s.route.size();
+    if (k<3) return false;
+    DistanceMatrix sub(k,vector<double>(k));
+    for (int a=0; a<k; ++a)
+        for (int b=0; b<k; ++b) sub[a][b]=I.d[s.route[a]][s.route[b]];
+    vector<int> order(k);
+    for (int a=0; a<k; ++a) order[a]=a;
+    localSearch(order,sub);
+    vector<int> next(k);
+    for (int a=0; a<k; ++a) next[a]=s.route[order[a]];
+    double t=routeTime(I,next);
+    if (t+OP_EPS>=s.time) return false;
+    s.route.swap(next);
+    s.time=t;
+    return true;
+}
+// 1-for-1 exchange: drop a chosen stop for an unchosen one with a larger prize
+bool swapStop(const Instance& I,State& s) {
+    int n=(int)I.d.size();
+    for (int p=1; p<(int)s.route.size(); ++p) {
+        int v=s.route[p];
+        vector<int> without(s.route);
+        without.erase(without.begin()+p);
+        double t=routeTime(I,without);
+        int pick=-1,at=-1; double pickCost=0,gain=OP_EPS;
+        for (int x=0; x<n; ++x) {
+            if (s.in[x] || I.prize[x]-I.prize[v]<=gain) continue;
+            if (s.fees-I.fee[v]+I.fee[x]>I.feeBudget+OP_EPS) continue;
+            auto ins=bestInsert(I,without,t,x);
+            if (ins.first<0) continue;
+            pick=x; at=ins.first; pickCost=ins.second; gain=I.prize[x]-I.prize[v];
+        }
+        if (pick<0) continue;
+        s.route.swap(without);
+        s.in[v]=0; s.time=t; s.fees-=I.fee[v]; s.prize-=I.prize[v];
+        s.add(I,pick,at,pickCost);
+        return true;
+    }
+    return false;
+}
+}
+OrienteeringResult orienteering(const DistanceMatrix& dist,const vector<double>& service,const vector<double>& prize,
+                                const vector<double>& fee,double timeBudget,double feeBudget) {
+    int n=(int)dist.size();
+    OrienteeringResult res;
+    if (n==0) return res;
+    Instance I{dist,service,prize,fee,timeBudget,feeBudget};
+    State s;
+    s.in.assign(n,0);
+    s.route={0};
+    s.in[0]=1;
+    s.time=service[0]; s.fees=fee[0]; s.prize=prize[0];
+    if (s.time>timeBudget+OP_EPS || s.fees>feeBudget+OP_EPS) return res;
+    fill(I,s);
+    // every step strictly improves (prize, -time), so this terminates
+    while (true) {
+        bool shorter=shorten(I,s);
+        bool more=fill(I,s);
+        if (!shorter && !more && !swapStop(I,s)) break;
+    }
+    res.order=s.route;
+    res.prize=s.prize;
+    res.time=s.time;
+    res.fees=s.fees;
+    return res;
+}
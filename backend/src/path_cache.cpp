@@ -0,0 +1,52 @@
+#include "../include/path_cache.h"
+#include "../include/graph.h"
+#include "../include/search_workspace.h"
+#include <algorithm>
+#include <limits>
+using namespace std;
+void ShortestPathCache::prepare(int source,const vector<int>& targets) {
+    int n=graph.csr().numNodes;
+    Tree& t=trees[source];
+    vector<int> todo;
+    for (int v:targets) if (v>=0 && v<n && !t.count(v)) todo.push_back(v);
+    if (todo.empty()) return;
+    SearchWorkspace& ws=SearchWorkspace::forThread();
+    dijkstraToTargets(graph,source,todo,ws);
+    // a target's ancestors are settled too; stop at the first one already kept
+    for (int v:todo) {
+        if (!ws.settled(v)) {
+            t[v]={numeric_limits<double>::infinity(),-1};
+            continue;
+        }
+        for (int u=v; u!=-1 && !t.count(u); u=ws.parent(u)) t[u]={ws.dist(u),ws.parent(u)};
+    }
+}
+const ShortestPathCache::Label* ShortestPathCache::label(int source,int target) {
+    prepare(source,{target});
+    const Tree& t=trees[source];
+    auto it=t.find(target);
+    return it==t.end() ? nullptr : &it->second;
+}
+double ShortestPathCache::distance(int source,int target) {
+    const Label* l=label(source,target);
+    return l ? l->dist : numeric_limits<double>::infinity();
+}
+vector<int> ShortestPathCache::path(int source,int target) {
+    const Label* l=label(source,target);
+    if (!l || l->dist==numeric_limits<double>::infinity()) return {};
+    const Tree& t=trees[source];
+    vector<int> p;
+    for (int u=target; u!=-1; u=t.at(u).parent) p.push_back(u);
+    reverse(p.begin(),p.end());
+    return p;
+}
+DistanceMatrix ShortestPathCache::matrix(const vector<int>& locs) {
+    int n=(int)locs.size();
+    DistanceMatrix dist(n,vector<double>(n,numeric_limits<double>::infinity()));
+    for (int i=0; i<n; ++i) {
+        prepare(locs[i],locs);
+        for (int j=0; j<n; ++j) dist[i][j]=distance(locs[i],locs[j]);
+        dist[i][i]=0;
+    }
+    return dist;
+}
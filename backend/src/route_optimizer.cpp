@@ -1,16 +1,17 @@
 #include "../include/route_optimizer.h"
 #include "../include/algorithms.h"
+#include "../include/path_cache.h"
+#include "../include/search_workspace.h"
+#include "../include/contraction_hierarchy.h"
+#include "../include/landmarks.h"
 #include <algorithm>
+#include <chrono>
+#include <unordered_map>
 #include <unordered_set>
 #include <limits>
 
 using namespace std;
 
-extern vector<Edge> kruskalMST(vector<Edge>& edges, int n);
-extern vector<int> mstToTour(const vector<Edge>& mst, int n, int start);
-extern vector<int> aStarPath(const Graph& g, int start, int goal);
-extern pair<vector<double>, vector<int>> dijkstraWithPath(const Graph& g, int start);
-
 // ---------------------------------------------------------
 // Helper: append a reconstructed segment to fullPath
 // ---------------------------------------------------------
@@ -25,12 +26,44 @@ static void appendSegment(vector<int>& fullPath, const vector<int>& segment) {
     }
 }
 
+// ---------------------------------------------------------
+// Engine dispatch for legs and stop-to-stop matrices
+// ---------------------------------------------------------
+pair<double, vector<int>> RouteOptimizer::leg(int u, int v, ShortestPathCache& cache) const {
+    if (usingCH()) return ch->shortestPath(u, v);
+    if (engine == PathEngine::BidirectionalAStar && landmarks && landmarks->isBuilt())
+        return bidirectionalAStar(*graphPtr, u, v, *landmarks);
+    if (engine == PathEngine::Bidirectional || engine == PathEngine::BidirectionalAStar)
+        return bidirectionalDijkstra(*graphPtr, u, v);
+
+    double d = cache.distance(u, v);
+    if (d == numeric_limits<double>::infinity()) return {d, {}};
+    return {d, cache.path(u, v)};
+}
+
+DistanceMatrix RouteOptimizer::stopMatrix(const vector<int>& locs, ShortestPathCache& cache) const {
+    if (usingCH()) return ch->distanceMatrix(locs);
+    return cache.matrix(locs);
+}
+
+string RouteOptimizer::engineSuffix() const {
+    if (usingCH()) return " (CH)";
+    if (engine == PathEngine::BidirectionalAStar && landmarks && landmarks->isBuilt())
+        return " (Bidirectional A*)";
+    if (engine == PathEngine::Bidirectional || engine == PathEngine::BidirectionalAStar)
+        return " (Bidirectional Dijkstra)";
+    return "";
+}
+
 // ---------------------------------------------------------
 // FULL GRAPH TRAVERSAL (MST + DFS + A*)
 // ---------------------------------------------------------
 RouteResult RouteOptimizer::computeFullGraphRoute() {
     RouteResult res;
+    if (!graphPtr) return res;
+    const Graph& graph = *graphPtr;
     res.algorithm = "Kruskal + DFS + A*";
+    if (landmarks && landmarks->isBuilt()) res.algorithm += " (ALT)";
 
     vector<int> nodes = graph.getAllAttractionIds();
     if (nodes.empty()) return res;
@@ -64,30 +97,35 @@ RouteResult RouteOptimizer::computeFullGraphRoute() {
 
     res.attractionIds = finalOrder;
 
+    // one tree per distinct source for the whole traversal
+    ShortestPathCache cache(graph);
+    SearchWorkspace& ws = SearchWorkspace::forThread();
     double total = 0;
 
     for (size_t i = 0; i + 1 < finalOrder.size(); ++i) {
         int u = finalOrder[i];
         int v = finalOrder[i + 1];
 
-        vector<int> path = aStarPath(graph, u, v);
+        vector<int> path = (landmarks && landmarks->isBuilt())
+            ? aStarPath(graph, u, v, *landmarks)
+            : aStarPath(graph, u, v);
 
         if (path.empty()) {
             // fallback Dijkstra
-            auto dres = dijkstraWithPath(graph, u);
-            if (dres.first[v] == numeric_limits<double>::infinity()) {
+            path = cache.path(u, v);
+            if (path.empty()) {
                 res.algorithm += " (Unreachable Segment)";
                 continue;
             }
-            path = reconstructPath(dres.second, u, v);
         }
 
         appendSegment(res.fullPath, path);
 
-        // accumulate time
+        // accumulate time; a hop can never cost more than its direct road
         for (size_t k = 0; k + 1 < path.size(); ++k) {
-            auto dres2 = dijkstraWithPath(graph, path[k]);
-            total += dres2.first[path[k + 1]];
+            int a = path[k], b = path[k + 1];
+            dijkstraToTargets(graph, a, {b}, ws, graph.getEdgeWeight(a, b));
+            total += ws.dist(b);
         }
     }
 
@@ -99,9 +137,12 @@ RouteResult RouteOptimizer::computeFullGraphRoute() {
 // FIXED ORDER (Dijkstra) + FLEXIBLE ORDER (TSP)
 // ---------------------------------------------------------
 RouteResult RouteOptimizer::computeOptimalRoute(const vector<int>& locs, bool flexible) {
+    // the budget covers the whole request, distance matrix included
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeBudgetMs);
     RouteResult rr;
 
-    if (locs.empty()) return rr;
+    if (locs.empty() || !graphPtr) return rr;
+    const Graph& graph = *graphPtr;
     if (locs.size() == 1) {
         rr.attractionIds = locs;
         rr.fullPath = locs;
@@ -114,24 +155,28 @@ RouteResult RouteOptimizer::computeOptimalRoute(const vector<int>& locs, bool fl
     // FIXED ORDER
     // --------------------
     if (!flexible) {
-        rr.algorithm = "Fixed Order";
+        rr.algorithm = "Fixed Order" + engineSuffix();
         rr.attractionIds = locs;
 
+        ShortestPathCache cache(graph);
         double total = 0;
 
-        for (size_t i = 0; i + 1 < locs.size(); ++i) {
-            int u = locs[i];
-            int v = locs[i + 1];
+        if (engine == PathEngine::Dijkstra && !usingCH()) {
+            // one early-exit search per distinct source, stopping at its next stops
+            unordered_map<int, vector<int>> nextStops;
+            for (size_t i = 0; i + 1 < locs.size(); ++i) nextStops[locs[i]].push_back(locs[i + 1]);
+            for (auto& s : nextStops) cache.prepare(s.first, s.second);
+        }
 
-            auto dres = dijkstraWithPath(graph, u);
-            if (dres.first[v] == numeric_limits<double>::infinity()) {
+        for (size_t i = 0; i + 1 < locs.size(); ++i) {
+            auto seg = leg(locs[i], locs[i + 1], cache);
+            if (seg.first == numeric_limits<double>::infinity()) {
                 total += 1e9;
                 continue;
             }
 
-            vector<int> segment = reconstructPath(dres.second, u, v);
-            appendSegment(rr.fullPath, segment);
-            total += dres.first[v];
+            appendSegment(rr.fullPath, seg.second);
+            total += seg.first;
         }
 
         rr.totalTime = total;
@@ -141,9 +186,35 @@ RouteResult RouteOptimizer::computeOptimalRoute(const vector<int>& locs, bool fl
     // --------------------
     // FLEXIBLE ORDER (TSP)
     // --------------------
-    rr.algorithm = "Flexible TSP";
-
-    auto tspRes = computeOptimalRouteFree(graph, locs);
+    rr.algorithm = "Flexible TSP" + engineSuffix();
+
+    // the trees behind the matrix are reused below to expand the path
+    ShortestPathCache cache(graph);
+    DistanceMatrix dist = stopMatrix(locs, cache);
+    pair<double, vector<int>> tspRes;
+    if (startTime >= 0) {
+        vector<double> service;
+        vector<OpenWindows> windows;
+        for (int id : locs) {
+            service.push_back(graph.getAttraction(id).visitDuration);
+            windows.push_back(graph.getAttraction(id).openWindows);
+        }
+        ScheduledTour sched = tspTimeWindows(dist, service, windows, startTime);
+        rr.algorithm = string("Flexible TSP with Time Windows") + (sched.exact ? " [Held-Karp]" : " [Insertion + Relocate]")
+                     + engineSuffix();
+        if (sched.order.empty()) return rr;
+        tspRes = {sched.finish - startTime, sched.order};
+        rr.visitStarts = sched.starts;
+    } else if (timeBudgetMs > 0) {
+        AnytimeTour best = tspAnytime(dist, deadline);
+        tspRes = {best.length, best.order};
+        rr.algorithm = "Flexible TSP [" + best.stage + "]" + engineSuffix();
+    } else if (multiStart.starts > 0 && (int)dist.size() > FLEXIBLE_EXACT_MAX) {
+        tspRes = tspMultiStart(dist, multiStart);
+        rr.algorithm = "Flexible TSP [Multi-Start]" + engineSuffix();
+    } else {
+        tspRes = computeOptimalRouteFree(dist);
+    }
     rr.totalTime = tspRes.first;
 
     for (int idx : tspRes.second)
@@ -154,10 +225,87 @@ RouteResult RouteOptimizer::computeOptimalRoute(const vector<int>& locs, bool fl
         int u = rr.attractionIds[i];
         int v = rr.attractionIds[i + 1];
 
-        auto dres = dijkstraWithPath(graph, u);
-        vector<int> segment = reconstructPath(dres.second, u, v);
-        appendSegment(rr.fullPath, segment);
+        appendSegment(rr.fullPath, leg(u, v, cache).second);
+    }
+
+    return rr;
+}
+
+// ---------------------------------------------------------
+// ORIENTEERING (best rated stops within a time/fee budget)
+// ---------------------------------------------------------
+RouteResult RouteOptimizer::computeOrienteeringRoute(int start, const vector<int>& candidates,
+                                                     double timeBudget, double feeBudget) {
+    RouteResult rr;
+    if (!graphPtr) return rr;
+    const Graph& graph = *graphPtr;
+    rr.algorithm = "Orienteering (Greedy Insertion + Local Search)" + engineSuffix();
+
+    vector<int> pool = candidates;
+    if (pool.empty()) pool = graph.getAllAttractionIds();
+    sort(pool.begin(), pool.end());
+    pool.erase(unique(pool.begin(), pool.end()), pool.end());
+    pool.erase(remove(pool.begin(), pool.end(), start), pool.end());
+
+    // one bounded search drops every stop the budget cannot even reach,
+    // so the matrix below only covers plausible stops on large graphs
+    double left = timeBudget - graph.getAttraction(start).visitDuration;
+    vector<int> locs = {start};
+    if (left >= 0 && !pool.empty()) {
+        SearchWorkspace& ws = SearchWorkspace::forThread();
+        dijkstraToTargets(graph, start, pool, ws, left);
+        for (int c : pool)
+            if (ws.settled(c) && ws.dist(c) + graph.getAttraction(c).visitDuration <= left)
+                locs.push_back(c);
+    }
+
+    vector<double> service, prize, fee;
+    for (int id : locs) {
+        const Attraction& a = graph.getAttraction(id);
+        service.push_back(a.visitDuration);
+        // rating weighted by how popular the place is (popularity is 0..100)
+        prize.push_back(a.rating * a.popularity / 100.0);
+        fee.push_back(a.entryFee);
     }
 
+    ShortestPathCache cache(graph);
+    OrienteeringResult best = orienteering(stopMatrix(locs, cache), service, prize, fee, timeBudget, feeBudget);
+    if (best.order.empty()) return rr;
+
+    for (int idx : best.order) rr.attractionIds.push_back(locs[idx]);
+    rr.totalTime = best.time;
+    rr.score = best.prize;
+    rr.totalFee = best.fees;
+
+    if (rr.attractionIds.size() == 1) rr.fullPath = rr.attractionIds;
+    for (size_t i = 0; i + 1 < rr.attractionIds.size(); ++i)
+        appendSegment(rr.fullPath, leg(rr.attractionIds[i], rr.attractionIds[i + 1], cache).second);
+
     return rr;
 }
+
+// ---------------------------------------------------------
+// MULTI-DAY ITINERARY (k day tours from the same start)
+// ---------------------------------------------------------
+vector<RouteResult> RouteOptimizer::computeMultiDayRoutes(const vector<int>& locs, int days, double dayLimit) {
+    vector<RouteResult> out;
+    if (locs.empty() || days <= 0 || !graphPtr) return out;
+    const Graph& graph = *graphPtr;
+
+    ShortestPathCache cache(graph);
+    vector<double> service;
+    for (int id : locs) service.push_back(graph.getAttraction(id).visitDuration);
+    vector<DayRoute> plan = planDays(stopMatrix(locs, cache), service, days, dayLimit);
+
+    for (const DayRoute& day : plan) {
+        RouteResult rr;
+        rr.algorithm = "Multi-Day VRP (k-Medoids + Day TSP + Inter-Day Exchange)" + engineSuffix();
+        for (int idx : day.order) rr.attractionIds.push_back(locs[idx]);
+        rr.totalTime = day.time;
+        if (rr.attractionIds.size() == 1) rr.fullPath = rr.attractionIds;
+        for (size_t i = 0; i + 1 < rr.attractionIds.size(); ++i)
+            appendSegment(rr.fullPath, leg(rr.attractionIds[i], rr.attractionIds[i + 1], cache).second);
+        out.push_back(rr);
+    }
+    return out;
+}
@@ -0,0 +1,46 @@
+#include "../include/search_workspace.h"
+#include <algorithm>
+#include <functional>
+using namespace std;
+void SearchWorkspace::reset(int n) {
+    if ((int)labelGen.size()<n) {
+        distLabel.resize(n);
+        parentLabel.resize(n);
+        labelGen.resize(n,0);
+        settledGen.resize(n,0);
+        markGen.resize(n,0);
+    }
+    heap.clear();
+    // generation 0 never marks anything; on wrap-around clear the stamps once
+    if (++generation==0) {
+        fill(labelGen.begin(),labelGen.end(),0);
+        fill(settledGen.begin(),settledGen.end(),0);
+        fill(markGen.begin(),markGen.end(),0);
+        generation=1;
+    }
+}
+void SearchWorkspace::push(double key,int v) {
+    heap.push_back({key,v});
+    push_heap(heap.begin(),heap.end(),greater<pair<double,int>>());
+}
+pair<double,int> SearchWorkspace::pop() {
+    pop_heap(heap.begin(),heap.end(),greater<pair<double,int>>());
+    pair<double,int> top=heap.back();
+    heap.pop_back();
+    return top;
+}
+vector<int> SearchWorkspace::path(int start,int target) const {
+    vector<int> out;
+    if (target<0 || target>=(int)labelGen.size() || !reached(target)) return out;
+    for (int x=target; x!=-1; x=parent(x)) {
+        out.push_back(x);
+        if (x==start) break;
+    }
+    if (out.back()!=start) return vector<int>();
+    reverse(out.begin(),out.end());
+    return out;
+}
+SearchWorkspace& SearchWorkspace::forThread(int slot) {
+    static thread_local SearchWorkspace ws[2];
+    return ws[slot];
+}
@@ -0,0 +1,266 @@
+#include "../include/graph.h"
+#include "../include/snapshot.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+using namespace std;
+static uint64_t align8(uint64_t x) { return (x+7) & ~(uint64_t)7; }
+bool Graph::saveSnapshot(const string& path) const {
+    CSRView c=csr();
+    if (c.numNodes==0 && numVertices>0) {
+        cerr<<"[graph] snapshot needs the CSR, call buildCSR() first\n";
+        return false;
+    }
+    // records in id order so the same graph always gives the same bytes
+    vector<int> ids=getAllAttractionIds();
+    sort(ids.begin(),ids.end());
+    string strings;
+    auto intern=[&](const string& s) {
+        SnapshotString r{(uint32_t)strings.size(),(uint32_t)s.size()};
+        strings+=s;
+        return r;
+    };
+    vector<SnapshotNode> nodes(ids.size());
+    vector<int32_t> recordOf(ids.empty() ? 0 : ids.back()+1,-1);
+    for (size_t i=0; i<ids.size(); ++i) {
+        const Attraction& a=getAttraction(ids[i]);
+        SnapshotNode& r=nodes[i];
+        r.id=a.id;
+        r.popularity=a.popularity;
+        r.latitude=a.latitude;
+        r.longitude=a.longitude;
+        r.visitDuration=a.visitDuration;
+        r.rating=a.rating;
+        r.entryFee=a.entryFee;
+        r.name=intern(a.name);
+        r.category=intern(a.category);
+        r.openingHours=intern(a.openingHours);
+        recordOf[a.id]=(int32_t)i;
+    }
+    vector<int32_t> nameIndex;
+    if (snapBase) {
+        nameIndex.assign(snapNameIndex,snapNameIndex+snapNames);
+    } else {
+        // nameToId is already sorted by name, and keeps the last of duplicates
+        for (auto& kv:nameToId) nameIndex.push_back(recordOf[kv.second]);
+    }
+
+    SnapshotHeader h;
+    memset(&h,0,sizeof(h));
+    memcpy(h.magic,SNAPSHOT_MAGIC,sizeof(h.magic));
+    h.version=SNAPSHOT_VERSION;
+    h.byteOrder=SNAPSHOT_BYTE_ORDER;
+    h.numNodes=c.numNodes;
+    h.numRecords=(int32_t)nodes.size();
+    h.numNames=(int32_t)nameIndex.size();
+    h.numArcs=c.numNodes>0 ? c.offsets[c.numNodes] : 0;
+    h.offsetsAt=align8(sizeof(SnapshotHeader));
+    h.targetsAt=align8(h.offsetsAt+sizeof(int32_t)*(c.numNodes>0 ? c.numNodes+1 : 0));
+    h.weightsAt=align8(h.targetsAt+sizeof(int32_t)*h.numArcs);
+    h.nodesAt=align8(h.weightsAt+sizeof(double)*h.numArcs);
+    h.nameIndexAt=align8(h.nodesAt+sizeof(SnapshotNode)*nodes.size());
+    h.stringsAt=align8(h.nameIndexAt+sizeof(int32_t)*nameIndex.size());
+    h.stringBytes=strings.size();
+    h.fileBytes=h.stringsAt+h.stringBytes;
+
+    ofstream out(path,ios::binary | ios::trunc);
+    if (!out) {
+        cerr<<"[graph] cannot write snapshot: "<<path<<"\n";
+        return false;
+    }
+    uint64_t written=0;
+    auto put=[&](uint64_t at,const void* data,uint64_t bytes) {
+        static const char zeros[8]={0};
+        out.write(zeros,at-written);
+        out.write((const char*)data,bytes);
+        written=at+bytes;
+    };
+    put(0,&h,sizeof(h));
+    if (c.numNodes>0) {
+        put(h.offsetsAt,c.offsets,sizeof(int32_t)*(c.numNodes+1));
+        put(h.targetsAt,c.targets,sizeof(int32_t)*h.numArcs);
+        put(h.weightsAt,c.weights,sizeof(double)*h.numArcs);
+    }
+    put(h.nodesAt,nodes.data(),sizeof(SnapshotNode)*nodes.size());
+    put(h.nameIndexAt,nameIndex.data(),sizeof(int32_t)*nameIndex.size());
+    put(h.stringsAt,strings.data(),strings.size());
+    out.close();
+    if (!out) {
+        cerr<<"[graph] failed writing snapshot: "<<path<<"\n";
+        return false;
+    }
+    return true;
+}
+bool Graph::loadSnapshot(const string& path) {
+    clearAll();
+    const char* base=nullptr;
+    size_t bytes=0;
+    bool mapped=false;
+#ifdef HAVE_MMAP
+    int fd=open(path.c_str(),O_RDONLY);
+    struct stat st;
+    if (fd>=0 && fstat(fd,&st)==0 && st.st_size>0) {
+        void* p=mmap(nullptr,(size_t)st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+        if (p!=MAP_FAILED) { base=(const char*)p; bytes=(size_t)st.st_size; mapped=true; }
+    }
+    if (fd>=0) close(fd);
+#endif
+    if (!base) {
+        // no mmap here: read the file into one (8-byte aligned) heap block
+        ifstream in(path,ios::binary | ios::ate);
+        if (in) {
+            bytes=(size_t)in.tellg();
+            char* buf=(char*)(new double[(bytes+7)/8]);
+            in.seekg(0);
+            if (bytes>0 && in.read(buf,bytes)) base=buf;
+            else delete[] (double*)buf;
+        }
+    }
+    if (!base) {
+        cerr<<"[graph] cannot open snapshot: "<<path<<"\n";
+        return false;
+    }
+    snapBase=base;
+    snapBytes=bytes;
+    snapMapped=mapped;
+
+    auto fail=[&](const char* why) {
+        cerr<<"[graph] bad snapshot "<<path<<": "<<why<<"\n";
+        clearAll();
+        return false;
+    };
+    if (bytes<sizeof(SnapshotHeader)) return fail("truncated header");
+    const SnapshotHeader& h=*(const SnapshotHeader*)base;
+    if (memcmp(h.magic,SNAPSHOT_MAGIC,sizeof(h.magic))!=0) return fail("not a graph snapshot");
+    if (h.byteOrder!=SNAPSHOT_BYTE_ORDER) return fail("written with a different byte order");
+    if (h.version!=SNAPSHOT_VERSION) return fail("unsupported version");
+    if (h.fileBytes!=bytes) return fail("size does not match the header");
+    if (h.numNodes<0 || h.numRecords<0 || h.numNames<0 || h.numNames>h.numRecords || h.numArcs<0)
+        return fail("negative counts");
+    // every section inside the file and 8-byte aligned
+    auto inside=[&](uint64_t at,uint64_t count,uint64_t size) {
+        return at%8==0 && at<=bytes && count<=(bytes-at)/size;
+    };
+    if (!inside(h.offsetsAt,h.numNodes>0 ? h.numNodes+1 : 0,sizeof(int32_t)) ||
+        !inside(h.targetsAt,h.numArcs,sizeof(int32_t)) || !inside(h.weightsAt,h.numArcs,sizeof(double)) ||
+        !inside(h.nodesAt,h.numRecords,sizeof(SnapshotNode)) || !inside(h.nameIndexAt,h.numNames,sizeof(int32_t)) ||
+        h.stringsAt>bytes || h.stringBytes>bytes-h.stringsAt)
+        return fail("section out of bounds");
+
+    snapCSR.numNodes=h.numNodes;
+    if (h.numNodes>0) {
+        snapCSR.offsets=(const int*)(base+h.offsetsAt);
+        snapCSR.targets=(const int*)(base+h.targetsAt);
+        snapCSR.weights=(const double*)(base+h.weightsAt);
+        if (snapCSR.offsets[0]!=0 || snapCSR.offsets[h.numNodes]!=h.numArcs) return fail("CSR offsets do not cover the arcs");
+        // every search and buildDSU index by these without further checks
+        for (int u=0; u<h.numNodes; ++u) {
+            if (snapCSR.offsets[u]>snapCSR.offsets[u+1]) return fail("CSR offsets decrease");
+            for (int e=snapCSR.offsets[u]; e<snapCSR.offsets[u+1]; ++e) {
+                int v=snapCSR.targets[e];
+                if (v<0 || v>=h.numNodes || v==u) return fail("bad CSR target");
+            }
+        }
+    }
+    snapNodes=(const SnapshotNode*)(base+h.nodesAt);
+    snapNameIndex=(const int*)(base+h.nameIndexAt);
+    snapStrings=base+h.stringsAt;
+    snapNames=h.numNames;
+
+    // records are only checked here, so snapAttraction can trust them later:
+    // ids strictly increasing (snapRecord searches them) and CSR nodes, strings
+    // inside the string table. No copies and no opening hours parsed yet.
+    auto text=[&](const SnapshotString& s) { return s.at<=h.stringBytes && s.length<=h.stringBytes-s.at; };
+    for (int i=0; i<h.numRecords; ++i) {
+        const SnapshotNode& r=snapNodes[i];
+        if (r.id<0 || r.id>=h.numNodes || (i>0 && r.id<=snapNodes[i-1].id)) return fail("bad attraction id");
+        if (!text(r.name) || !text(r.category) || !text(r.openingHours)) return fail("bad attraction record");
+    }
+    snapRecords=h.numRecords;
+    maxId=h.numNodes-1;
+    // getIdByName binary-searches the index: in range and strictly sorted
+    auto nameOf=[&](int i) {
+        const SnapshotString& s=snapNodes[snapNameIndex[i]].name;
+        return string_view(snapStrings+s.at,s.length);
+    };
+    for (int i=0; i<snapNames; ++i) {
+        if (snapNameIndex[i]<0 || snapNameIndex[i]>=h.numRecords) return fail("bad name index");
+        if (i>0 && !(nameOf(i-1)<nameOf(i))) return fail("name index not sorted");
+    }
+    numVertices=h.numRecords;
+    buildDSU();
+    return true;
+}
+const SnapshotNode* Graph::snapRecord(int id) const {
+    if (id<0 || snapRecords==0) return nullptr;
+    // dense ids sit at their own index, otherwise binary search the id order
+    if (id<snapRecords && snapNodes[id].id==id) return &snapNodes[id];
+    const SnapshotNode* end=snapNodes+snapRecords;
+    const SnapshotNode* r=lower_bound(snapNodes,end,id,[](const SnapshotNode& n,int v) { return n.id<v; });
+    return r!=end && r->id==id ? r : nullptr;
+}
+Attraction Graph::snapAttraction(const SnapshotNode& r) const {
+    Attraction a;
+    a.id=r.id;
+    a.popularity=r.popularity;
+    a.latitude=r.latitude;
+    a.longitude=r.longitude;
+    a.visitDuration=r.visitDuration;
+    a.rating=r.rating;
+    a.entryFee=r.entryFee;
+    a.name.assign(snapStrings+r.name.at,r.name.length);
+    a.category.assign(snapStrings+r.category.at,r.category.length);
+    a.openingHours.assign(snapStrings+r.openingHours.at,r.openingHours.length);
+    if (!a.openingHours.empty()) parseOpeningHours(a.openingHours,a.openWindows);
+    return a;
+}
+void Graph::releaseSnapshot() {
+    if (!snapBase) return;
+#ifdef HAVE_MMAP
+    if (snapMapped) munmap((void*)snapBase,snapBytes);
+    else delete[] (const double*)snapBase;
+#else
+    delete[] (const double*)snapBase;
+#endif
+    snapBase=nullptr;
+    snapBytes=0;
+    snapMapped=false;
+    snapCSR=CSRView();
+    snapNodes=nullptr;
+    snapRecords=0;
+    snapAttractions.clear();
+    snapNameIndex=nullptr;
+    snapStrings=nullptr;
+    snapNames=0;
+}
+void Graph::detachSnapshot() {
+    if (!snapBase) return;
+    // back to owned containers: CSR copies, adjList and nameToId rebuilt so
+    // addEdge/buildCSR keep working as if the graph had come from the CSVs
+    CSRView c=snapCSR;
+    if (c.numNodes>0) {
+        csrOffsets.assign(c.offsets,c.offsets+c.numNodes+1);
+        csrTargets.assign(c.targets,c.targets+c.offsets[c.numNodes]);
+        csrWeights.assign(c.weights,c.weights+c.offsets[c.numNodes]);
+    }
+    attractions.reserve(snapRecords);
+    for (int i=0; i<snapRecords; ++i) attractions.emplace(snapNodes[i].id,snapAttraction(snapNodes[i]));
+    for (auto& kv:attractions) adjList[kv.first];
+    for (int u=0; u<c.numNodes; ++u) {
+        for (int e=c.offsets[u]; e<c.offsets[u+1]; ++e) adjList[u].push_back({c.targets[e],c.weights[e]});
+    }
+    for (int i=0; i<snapNames; ++i) {
+        const SnapshotNode& r=snapNodes[snapNameIndex[i]];
+        nameToId[string(snapStrings+r.name.at,r.name.length)]=r.id;
+    }
+    releaseSnapshot();
+}
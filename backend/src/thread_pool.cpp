@@ -0,0 +1,56 @@
+#include "../include/thread_pool.h"
+#include <algorithm>
+using namespace std;
+ThreadPool::ThreadPool(int threads) {
+    if (threads<=0) threads=max(1u,thread::hardware_concurrency());
+    for (int i=1; i<threads; ++i) workers.emplace_back([this] { workerLoop(); });
+}
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> g(lock);
+        stopping=true;
+    }
+    wake.notify_all();
+    for (thread& t:workers) t.join();
+}
+void ThreadPool::runJob() {
+    for (int i=next.fetch_add(1); i<jobCount; i=next.fetch_add(1)) (*job)(i);
+}
+void ThreadPool::workerLoop() {
+    unsigned long long seen=0;
+    unique_lock<mutex> g(lock);
+    while (true) {
+        wake.wait(g,[&] { return stopping || jobId!=seen; });
+        if (stopping) return;
+        seen=jobId;
+        g.unlock();
+        runJob();
+        g.lock();
+        if (--busy==0) finished.notify_one();
+    }
+}
+void ThreadPool::parallelFor(int count,const function<void(int)>& fn) {
+    if (count<=0) return;
+    if (workers.empty() || count==1) {
+        for (int i=0; i<count; ++i) fn(i);
+        return;
+    }
+    lock_guard<mutex> serial(submit);
+    {
+        lock_guard<mutex> g(lock);
+        job=&fn;
+        jobCount=count;
+        next=0;
+        busy=(int)workers.size();
+        ++jobId;
+    }
+    wake.notify_all();
+    runJob();
+    unique_lock<mutex> g(lock);
+    finished.wait(g,[&] { return busy==0; });
+    job=nullptr;
+}
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
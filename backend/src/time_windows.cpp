@@ -0,0 +1,211 @@
+#include "../include/algorithms.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+using namespace std;
+static const double TW_INF=numeric_limits<double>::infinity();
+static const double TW_EPS=1e-9;
+double earliestVisit(const OpenWindows& windows,double arrival,double service) {
+    if (windows.empty()) return arrival;
+    for (auto& w:windows) {
+        double begin=max(arrival,w.first);
+        if (begin+service<=w.second+TW_EPS) return begin;
+    }
+    return TW_INF;
+}
+namespace {
+struct TWInstance {
+    const DistanceMatrix& d;
+    const vector<double>& service;
+    const vector<OpenWindows>& windows;
+    double startTime;
+    vector<double> latest;   // last moment a visit can still begin, inf if always open
+    TWInstance(const DistanceMatrix& d,const vector<double>& service,const vector<OpenWindows>& windows,double startTime)
+        :d(d),service(service),windows(windows),startTime(startTime),latest(d.size(),TW_INF) {
+        for (size_t k=0; k<d.size(); ++k) {
+            if (windows[k].empty()) continue;
+            latest[k]=-TW_INF;
+            for (auto& w:windows[k]) latest[k]=max(latest[k],w.second-service[k]);
+        }
+    }
+    double visit(int from,double leave,int to) const { return earliestVisit(windows[to],leave+d[from][to],service[to]); }
+    // Leaving `from` at `leave` with `left` still to visit: can every one of them
+    // still be reached in time? Shortest times obey the triangle inequality, so
+    // going straight there is the earliest possible arrival.
+    template <class Pending>
+    bool alive(int from,double leave,Pending left) const {
+        bool ok=true;
+        left([&](int k) { if (leave+d[from][k]>latest[k]+TW_EPS) ok=false; });
+        return ok;
+    }
+    // Finish time of the open path. A stop no window fits is visited late
+    // anyway and charged its lateness (plus 1 per miss) in `late`; the walk
+    // stops, returning infinity, as soon as the order can no longer beat
+    // (bestLate, bestFinish) since both only ever grow along the path.
+    double simulate(const vector<int>& order,double bestLate,double bestFinish,double& late,
+                    vector<double>* starts=nullptr) const {
+        double t=startTime;
+        late=0;
+        if (starts) starts->assign(1,startTime);
+        for (size_t i=1; i<order.size(); ++i) {
+            int k=order[i];
+            double arrive=t+d[order[i-1]][k];
+            double s=earliestVisit(windows[k],arrive,service[k]);
+            if (s==TW_INF) { late+=1+max(0.0,arrive-latest[k]); s=arrive; }
+            t=s+service[k];
+            if (late>bestLate+TW_EPS || (late>=bestLate-TW_EPS && t>bestFinish)) return TW_INF;
+            if (starts) starts->push_back(s);
+        }
+        return t;
+    }
+};
+// Held-Karp on earliest finish: waiting is allowed, so reaching (S,j) sooner
+// never hurts and one label per state is exact. States from which some
+// unvisited stop can no longer make its last window are dropped on creation.
+vector<int> exactOrder(const TWInstance& I) {
+    int n=(int)I.d.size(),m=n-1;
+    unsigned ALL=(1u<<m)-1;
+    vector<double> f((size_t)m<<m,TW_INF);   // f[S*m+j]: visit start at stop j+1
+    vector<uint8_t> from((size_t)m<<m,0xff);
+    auto leaveAt=[&](unsigned S,int j) { return f[(size_t)S*m+j]+I.service[j+1]; };
+    auto pending=[&](unsigned S) {
+        return [S,m](auto fn) { for (int k=0; k<m; ++k) if (!(S>>k & 1)) fn(k+1); };
+    };
+    for (int j=0; j<m; ++j) {
+        double s=I.visit(0,I.startTime,j+1);
+        if (s==TW_INF) return {};   // unreachable in time even as the first stop
+        f[(size_t)(1u<<j)*m+j]=s;
+    }
+    for (unsigned S=1; S<ALL; ++S) {
+        for (int j=0; j<m; ++j) {
+            if (!(S>>j & 1) || f[(size_t)S*m+j]==TW_INF) continue;
+            double leave=leaveAt(S,j);
+            if (!I.alive(j+1,leave,pending(S))) { f[(size_t)S*m+j]=TW_INF; continue; }
+            for (int k=0; k<m; ++k) {
+                if (S>>k & 1) continue;
+                double s=I.visit(j+1,leave,k+1);
+                size_t idx=(size_t)(S|1u<<k)*m+k;
+                if (s<f[idx]) { f[idx]=s; from[idx]=(uint8_t)j; }
+            }
+        }
+    }
+    int last=-1; double best=TW_INF;
+    for (int j=0; j<m; ++j) {
+        if (f[(size_t)ALL*m+j]==TW_INF) continue;
+        double fin=leaveAt(ALL,j);
+        if (fin<best) { best=fin; last=j; }
+    }
+    if (last==-1) return {};
+    vector<int> order;
+    unsigned S=ALL;
+    for (int j=last; j!=0xff; ) {
+        order.push_back(j+1);
+        int prev=from[(size_t)S*m+j];
+        S^=1u<<j;
+        j=prev;
+    }
+    order.push_back(0);
+    reverse(order.begin(),order.end());
+    return order;
+}
+// Build a route one stop at a time, taking the best stop that leaves every
+// other stop reachable, else the best visitable one, else the most urgent
+// one (visited late, for the repair moves below to sort out)
+vector<int> constructOrder(const TWInstance& I,bool byDeadline) {
+    int n=(int)I.d.size();
+    vector<char> done(n,0);
+    vector<int> order={0};
+    done[0]=1;
+    double t=I.startTime;
+    for (int step=1; step<n; ++step) {
+        int cur=order.back(),pick=-1,fallback=-1,urgent=-1;
+        double pickKey=TW_INF,fallbackKey=TW_INF,pickFin=0,fallbackFin=0;
+        for (int k=0; k<n; ++k) {
+            if (done[k]) continue;
+            if (urgent==-1 || I.latest[k]<I.latest[urgent]) urgent=k;
+            double s=I.visit(cur,t,k);
+            if (s==TW_INF) continue;
+            double fin=s+I.service[k];
+            // deadline order serves the tightest closing stop first
+            double key=byDeadline ? I.latest[k] : fin;
+            if (key<fallbackKey || (key==fallbackKey && fin<fallbackFin)) { fallbackKey=key; fallback=k; fallbackFin=fin; }
+            done[k]=1;
+            bool ok=I.alive(k,fin,[&](auto fn) { for (int u=0; u<n; ++u) if (!done[u]) fn(u); });
+            done[k]=0;
+            if (ok && (key<pickKey || (key==pickKey && fin<pickFin))) { pickKey=key; pick=k; pickFin=fin; }
+        }
+        if (pick==-1) { pick=fallback; pickFin=fallbackFin; }
+        if (pick==-1) { pick=urgent; pickFin=t+I.d[cur][urgent]+I.service[urgent]; }
+        t=pickFin;
+        done[pick]=1;
+        order.push_back(pick);
+    }
+    return order;
+}
+// First-improvement relocate and reversal moves on (lateness, finish): late
+// orders are repaired first, then the finish time shortened. Every trial is
+// cut off as soon as its partial schedule is already worse than the best.
+void improveOrder(const TWInstance& I,vector<int>& order,double& late,double& finish) {
+    int n=(int)order.size();
+    vector<int> trial;
+    double trialLate;
+    auto better=[&](double fin) {
+        if (fin==TW_INF) return false;
+        if (trialLate<late-TW_EPS || (trialLate<=late+TW_EPS && fin<finish-TW_EPS)) {
+            late=trialLate; finish=fin; order.swap(trial);
+            return true;
+        }
+        return false;
+    };
+    bool improved=true;
+    while (improved) {
+        improved=false;
+        for (int i=1; i<n && !improved; ++i) {
+            for (int j=1; j<n && !improved; ++j) {
+                if (i==j) continue;
+                trial=order;
+                int x=trial[i];
+                trial.erase(trial.begin()+i);
+                trial.insert(trial.begin()+j,x);
+                improved=better(I.simulate(trial,late,finish,trialLate));
+            }
+        }
+        for (int i=1; i+1<n && !improved; ++i) {
+            for (int j=i+1; j<n && !improved; ++j) {
+                trial=order;
+                reverse(trial.begin()+i,trial.begin()+j+1);
+                improved=better(I.simulate(trial,late,finish,trialLate));
+            }
+        }
+    }
+}
+}
+ScheduledTour tspTimeWindows(const DistanceMatrix& dist,const vector<double>& service,
+                             const vector<OpenWindows>& windows,double startTime) {
+    int n=(int)dist.size();
+    ScheduledTour res;
+    if (n==0) return res;
+    TWInstance I(dist,service,windows,startTime);
+    vector<int> order;
+    if (n<=TIME_WINDOW_EXACT_MAX) {
+        order=n==1 ? vector<int>{0} : exactOrder(I);
+        res.exact=true;
+    } else {
+        double bestLate=TW_INF,bestFinish=TW_INF;
+        for (bool byDeadline:{false,true}) {
+            vector<int> cand=constructOrder(I,byDeadline);
+            double late,finish=I.simulate(cand,TW_INF,TW_INF,late);
+            improveOrder(I,cand,late,finish);
+            if (late<bestLate-TW_EPS || (late<=bestLate+TW_EPS && finish<bestFinish)) {
+                bestLate=late; bestFinish=finish; order.swap(cand);
+            }
+        }
+        if (bestLate>0) order.clear();
+    }
+    if (order.empty()) return res;
+    double late;
+    res.finish=I.simulate(order,TW_INF,TW_INF,late,&res.starts);
+    res.order=order;
+    return res;
+}
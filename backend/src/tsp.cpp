@@ -1,22 +1,22 @@
 #include "../include/algorithms.h"
 #include "../include/graph.h"
+#include "../include/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <limits>
 #include <algorithm>
 #include <unordered_set>
 #include <vector>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
 using namespace std;
 const double INF=numeric_limits<double>::infinity();
-static vector<vector<double>> generateDistanceMatrix(const Graph& g,const vector<int>& locs) {
-    int n =(int)locs.size();
-    vector<vector<double>> dist(n,vector<double>(n,INF));
-    for (int i=0; i<n; ++i) {
-        auto d=dijkstra(g,locs[i]);
-        for (int j=0; j<n; ++j) {
-            if (j<(int)d.size()) dist[i][j]=d[locs[j]];
-        }
-        dist[i][i]=0;
-    }
-    return dist;
+double tourLength(const vector<int>& tour,const DistanceMatrix& dist) {
+    double total=0;
+    for (int i=0; i+1<(int)tour.size(); ++i) total+=dist[tour[i]][tour[i+1]];
+    return total;
 }
 pair<double,vector<int>> computeOrderedRoute(const Graph& g,const vector<int>& order) {
     double total=0;
@@ -30,61 +30,287 @@ pair<double,vector<int>> computeOrderedRoute(const Graph& g,const vector<int>& o
     }
     return {total,r};
 }
+// Held-Karp state (S,j): cheapest path from node 0 through every stop in S
+// ending at j, where S never contains j. Node 0 is the fixed start and stays
+// out of the masks, so stop b+1 is bit b and j's own bit is squeezed out of S:
+// each of the m=n-1 ends owns a block of 2^(m-1) subsets, half the table of
+// the classic (mask,last) layout.
+static inline size_t squeeze(unsigned S,int j) {
+    return (S & ((1u<<j)-1)) | ((S>>(j+1))<<j);
+}
+size_t heldKarpTableBytes(int n) {
+    if (n<3) return 0;
+    // masks are 32 bit; far past any budget anyway, and the shift below would overflow
+    if (n>33) return numeric_limits<size_t>::max();
+    size_t states=(size_t)(n-1)<<(n-2);
+    return states*(sizeof(float)+sizeof(uint8_t));
+}
+namespace {
+const float FINF=numeric_limits<float>::infinity();
+const uint8_t FROM_START=0xff;
+// Min-plus kernel: for every successor j in `targets` (a bitmask),
+//   best[j] = min(best[j], via[k] + d[k*width + j]) over k in ks,
+// with arg[j] recording the winning k. k runs in ascending order with a
+// strict <, so every kernel picks the same k on ties. Kernels may also
+// overwrite lanes outside `targets`; callers ignore those.
+typedef void (*MinPlusFn)(const float* d,int width,const int* ks,int nk,const float* via,
+                          unsigned targets,float* best,int32_t* arg);
+void minPlusScalar(const float* d,int width,const int* ks,int nk,const float* via,
+                   unsigned targets,float* best,int32_t* arg) {
+    for (; targets; targets&=targets-1) {
+        int j=__builtin_ctz(targets);
+        float b=best[j];
+        int32_t a=arg[j];
+        for (int t=0; t<nk; ++t) {
+            int k=ks[t];
+            float c=via[k]+d[(size_t)k*width+j];
+            // select instead of branch: which k wins is data dependent
+            a=c<b ? k : a;
+            b=c<b ? c : b;
+        }
+        best[j]=b;
+        arg[j]=a;
+    }
+}
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_AVX2_KERNEL 1
+// 8 successors per instruction; width is a multiple of 8 (padded rows)
+__attribute__((target("avx2")))
+void minPlusAVX2(const float* d,int width,const int* ks,int nk,const float* via,
+                 unsigned,float* best,int32_t* arg) {
+    for (int j=0; j<width; j+=8) {
+        __m256 b=_mm256_loadu_ps(best+j);
+        __m256i a=_mm256_loadu_si256((const __m256i*)(arg+j));
+        for (int t=0; t<nk; ++t) {
+            int k=ks[t];
+            __m256 c=_mm256_add_ps(_mm256_set1_ps(via[k]),_mm256_loadu_ps(d+(size_t)k*width+j));
+            __m256 lt=_mm256_cmp_ps(c,b,_CMP_LT_OQ);
+            b=_mm256_blendv_ps(b,c,lt);
+            a=_mm256_blendv_epi8(a,_mm256_set1_epi32(k),_mm256_castps_si256(lt));
+        }
+        _mm256_storeu_ps(best+j,b);
+        _mm256_storeu_si256((__m256i*)(arg+j),a);
+    }
+}
+#endif
+bool cpuHasAVX2() {
+#ifdef HAVE_AVX2_KERNEL
+    static const bool has=__builtin_cpu_supports("avx2");
+    return has;
+#else
+    return false;
+#endif
+}
+atomic<int> kernelChoice((int)MinPlusKernel::Auto);
+MinPlusFn pickKernel() {
+    MinPlusKernel want=(MinPlusKernel)kernelChoice.load();
+#ifdef HAVE_AVX2_KERNEL
+    if (want!=MinPlusKernel::Scalar && cpuHasAVX2()) return minPlusAVX2;
+#endif
+    return minPlusScalar;
+}
+struct RelaxScratch {
+    vector<int> ks;
+    vector<float> via,best;
+    vector<int32_t> arg;
+};
+struct HeldKarpTable {
+    int m;
+    int width;   // m rounded up to the 8-float AVX2 lane count
+    size_t half;
+    unsigned ALL;
+    // d[k*width+j]: stop k+1 -> stop j+1, padded with +inf; start[j]: node 0 -> stop j+1
+    vector<float> d,start;
+    vector<float> cost;
+    vector<uint8_t> from;
+    MinPlusFn kernel;
+    explicit HeldKarpTable(const DistanceMatrix& dist)
+        :m((int)dist.size()-1),width((m+7)/8*8),half((size_t)1<<(m-1)),ALL((1u<<m)-1),
+         d((size_t)m*width,FINF),start(width,FINF),cost((size_t)m*half),from((size_t)m*half),
+         kernel(pickKernel()) {
+        for (int k=0; k<m; ++k) {
+            start[k]=(float)dist[0][k+1];
+            for (int j=0; j<m; ++j) d[(size_t)k*width+j]=(float)dist[k+1][j+1];
+        }
+    }
+    RelaxScratch scratch() const {
+        RelaxScratch s;
+        s.ks.resize(m);
+        s.via.resize(m);
+        s.best.resize(width);
+        s.arg.resize(width);
+        return s;
+    }
+    // pull every (S,j) from the (S\{k},k) states; reads only subsets one
+    // element smaller and writes only S's own states
+    void relax(unsigned S,RelaxScratch& s) {
+        // walk set bits directly: testing every bit is an unpredictable branch per stop
+        int nk=0;
+        for (unsigned rest=S; rest; rest&=rest-1) {
+            int k=__builtin_ctz(rest);
+            s.ks[nk++]=k;
+            s.via[k]=cost[(size_t)k*half+squeeze(S^(1u<<k),k)];
+        }
+        // the AVX2 kernel relaxes every lane, members of S included; only j outside S is kept
+        if (S==0) copy(start.begin(),start.end(),s.best.begin());
+        else fill(s.best.begin(),s.best.end(),FINF);
+        fill(s.arg.begin(),s.arg.end(),(int32_t)FROM_START);
+        kernel(d.data(),width,s.ks.data(),nk,s.via.data(),ALL & ~S,s.best.data(),s.arg.data());
+        for (unsigned rest=ALL & ~S; rest; rest&=rest-1) {
+            int j=__builtin_ctz(rest);
+            size_t idx=(size_t)j*half+squeeze(S,j);
+            cost[idx]=s.best[j];
+            from[idx]=(uint8_t)s.arg[j];
+        }
+    }
+    pair<double,vector<int>> extract(const DistanceMatrix& dist) const {
+        float best=FINF; int last=-1;
+        for (int j=0; j<m; ++j) {
+            float c=cost[(size_t)j*half+half-1];
+            if (c<best) { best=c; last=j; }
+        }
+        if (last==-1) return {INF,{}};
+        vector<int> order;
+        unsigned S=ALL^(1u<<last);
+        for (int j=last; ; ) {
+            order.push_back(j+1);
+            uint8_t k=from[(size_t)j*half+squeeze(S,j)];
+            if (k==FROM_START) break;
+            S^=1u<<k;
+            j=k;
+        }
+        order.push_back(0);
+        reverse(order.begin(),order.end());
+        // report the double-precision length, the float table only picks the order
+        return {tourLength(order,dist),order};
+    }
+};
+// the r-th (0-based) mask with p bits set, in increasing numeric order
+// (combinatorial number system: r = sum C(c_i, i) over the set bits c_i)
+unsigned unrankSubset(unsigned long long r,int p,const vector<vector<unsigned long long>>& C) {
+    unsigned S=0;
+    int c=(int)C.size()-1;
+    for (int i=p; i>=1; --i) {
+        while (C[c][i]>r) --c;
+        S|=1u<<c;
+        r-=C[c][i];
+        --c;
+    }
+    return S;
+}
+}
+void setMinPlusKernel(MinPlusKernel kernel) {
+    kernelChoice=(int)kernel;
+}
+const char* activeMinPlusKernel() {
+    return pickKernel()==minPlusScalar ? "scalar" : "avx2";
+}
+namespace {
+typedef chrono::steady_clock Clock;
+bool expired(const Clock::time_point* deadline) { return deadline && Clock::now()>=*deadline; }
+// Rough lower bound on the fill time: m=n-1 ends times 2^(m-1) subsets, each
+// relaxed over up to m predecessors. The AVX2 fill measured 0.9-2 ns per
+// relaxation from 12 to 22 stops on one core (0.9 at 22); the scalar kernel
+// is slower, so an estimate past the time left means the fill cannot finish
+const double HELD_KARP_NS_PER_RELAX=0.75;
+chrono::nanoseconds heldKarpFillEstimate(int n,int threads) {
+    int m=n-1;
+    double relaxations=(double)m*m*(double)((size_t)1<<(m-1));
+    return chrono::nanoseconds((long long)(relaxations*HELD_KARP_NS_PER_RELAX/max(threads,1)));
+}
+// Fill the whole table; with a deadline the fill gives up (returns false)
+// once it passes, checked every 1024 subsets
+bool fillSerial(HeldKarpTable& hk,const Clock::time_point* deadline) {
+    RelaxScratch s=hk.scratch();
+    // every S is numerically larger than its subsets, so a plain ascending
+    // sweep always finds the S\{k} states it reads already done
+    for (unsigned S=0; S<hk.ALL; ++S) {
+        if ((S&1023)==0 && expired(deadline)) return false;
+        hk.relax(S,s);
+    }
+    return true;
+}
+bool fillLayers(HeldKarpTable& hk,ThreadPool& pool,const Clock::time_point* deadline) {
+    int m=hk.m;
+    vector<vector<unsigned long long>> C(m+1,vector<unsigned long long>(m+1,0));
+    for (int a=0; a<=m; ++a) {
+        C[a][0]=1;
+        for (int b=1; b<=a; ++b) C[a][b]=C[a-1][b-1]+C[a-1][b];
+    }
+    atomic<bool> late(false);
+    // all subsets of one popcount only read the previous layer, so a layer is
+    // split into chunks of consecutive masks; every state is still computed
+    // exactly once with the same arithmetic, so the tour does not depend on
+    // the thread count or scheduling
+    for (int p=0; p<m; ++p) {
+        unsigned long long total=C[m][p];
+        unsigned long long chunk=max<unsigned long long>(256,total/((unsigned long long)pool.size()*8));
+        int tasks=(int)((total+chunk-1)/chunk);
+        pool.parallelFor(tasks,[&](int t) {
+            if (late || expired(deadline)) { late=true; return; }
+            RelaxScratch s=hk.scratch();
+            unsigned long long begin=(unsigned long long)t*chunk;
+            unsigned long long end=min(total,begin+chunk);
+            unsigned S=unrankSubset(begin,p,C);
+            for (unsigned long long r=begin; r<end; ++r) {
+                hk.relax(S,s);
+                if (S==0) break;
+                // Gosper's hack: next larger mask with the same popcount
+                unsigned low=S & (~S+1);
+                unsigned ripple=S+low;
+                S=(((ripple^S)>>2)/low) | ripple;
+            }
+        });
+        if (late) return false;
+    }
+    return true;
+}
+}
 pair<double,vector<int>> tspDP(const vector<vector<double>>& dist) {
     int n=(int)dist.size();
     if (n==0) return {0,{}};
     if (n==1) return {0,{0}};
-    if (n > 15) return {INF,{}};
-    int ALL=1 << n;
-    vector<vector<double>> dp(ALL,vector<double>(n,INF));
-    vector<vector<int>> parent(ALL,vector<int>(n,-1));
-    dp[1][0]=0;
-    for (int mask=1; mask<ALL; ++mask) {
-        for (int u=0; u<n; ++u) {
-            if (!(mask & (1<<u))) continue;
-            if (dp[mask][u]==INF) continue;
-            for (int v=0; v<n; ++v) {
-                if (mask & (1<<v)) continue;
-                if (dist[u][v]==INF) continue;
-                int nm=mask | (1<<v);
-                double nd=dp[mask][u]+dist[u][v];
-                if (nd<dp[nm][v]) { dp[nm][v]=nd; parent[nm][v]=u; }
-            }
-        }
-    }
-    int full=ALL-1; double best=INF; int last=-1;
-    for (int i=0; i<n; ++i) if (dp[full][i]<best) { best=dp[full][i]; last=i; }
-    vector<int> order;
-    int mask=full;
-    while (last!=-1) {
-        order.push_back(last);
-        int p=parent[mask][last];
-        if (p!=-1) mask^=(1<<last);
-        last=p;
-    }
-    reverse(order.begin(),order.end());
-    return {best,order};
+    if (n==2) return {dist[0][1],{0,1}};
+    if (heldKarpTableBytes(n)>HELD_KARP_MAX_BYTES) return {INF,{}};
+    HeldKarpTable hk(dist);
+    fillSerial(hk,nullptr);
+    return hk.extract(dist);
+}
+pair<double,vector<int>> tspDPParallel(const DistanceMatrix& dist,ThreadPool& pool) {
+    int n=(int)dist.size();
+    if (n<=2 || pool.size()==1) return tspDP(dist);
+    if (heldKarpTableBytes(n)>HELD_KARP_MAX_BYTES) return {INF,{}};
+    HeldKarpTable hk(dist);
+    fillLayers(hk,pool,nullptr);
+    return hk.extract(dist);
+}
+pair<double,vector<int>> tspDPParallel(const DistanceMatrix& dist) {
+    return tspDPParallel(dist,ThreadPool::shared());
 }
 pair<double,vector<int>> tspMSTApproximation(const Graph& g,const vector<int>& locs) {
-    int n=(int)locs.size();
+    if (locs.empty()) return {0,{}};
+    return tspMSTApproximation(buildDistanceMatrix(g,locs));
+}
+pair<double,vector<int>> tspMSTApproximation(const DistanceMatrix& dist) {
+    int n=(int)dist.size();
     if (n==0) return {0,{}};
-    auto dist=generateDistanceMatrix(g,locs);
     vector<Edge> edges;
     for (int i=0; i<n; ++i)
         for (int j=i+1; j<n; ++j)
             edges.push_back({i,j,dist[i][j]});
     vector<Edge> mst=kruskalMST(edges,n);
     vector<int> tour=mstToTour(mst,n,0);
-    double total=0;
-    for (int i=0; i+1<(int)tour.size(); ++i)
-        total+=dist[tour[i]][tour[i+1]];
-    twoOptImprovement(tour,dist);
-    return {total,tour};
+    localSearch(tour,dist);
+    // measured after local search so the reported time matches the returned order
+    return {tourLength(tour,dist),tour};
 }
 pair<double,vector<int>> greedyTSP(const Graph& g,int start,const vector<int>& locs) {
-    int n=(int)locs.size();
+    if (locs.empty()) return {0,{}};
+    return greedyTSP(buildDistanceMatrix(g,locs));
+}
+pair<double,vector<int>> greedyTSP(const DistanceMatrix& dist) {
+    int n=(int)dist.size();
     if (n==0) return {0,{}};
-    auto dist=generateDistanceMatrix(g,locs);
     unordered_set<int> used;
     vector<int> order;
     used.insert(0); order.push_back(0);
@@ -97,8 +323,7 @@ pair<double,vector<int>> greedyTSP(const Graph& g,int start,const vector<int>& l
         if (nxt==-1) break;
         used.insert(nxt); order.push_back(nxt); cur=nxt;
     }
-    double total=0; for (int i=0; i+1<(int)order.size(); ++i) total+=dist[order[i]][order[i+1]];
-    return {total,order};
+    return {tourLength(order,dist),order};
 }
 void twoOptImprovement(vector<int>& tour,const vector<vector<double>>& dist) {
     int n=(int)tour.size();
@@ -116,13 +341,65 @@ void twoOptImprovement(vector<int>& tour,const vector<vector<double>>& dist) {
     }
 }
 pair<double,vector<int>> computeOptimalRouteFree(const Graph& g,const vector<int>& locs) {
-    int n=(int)locs.size();
-    if (n<=10) return tspDP(generateDistanceMatrix(g,locs));
-    if (n<=15) {
-        auto dp=tspDP(generateDistanceMatrix(g,locs));
-        auto mst=tspMSTApproximation(g,locs);
-        if (dp.first<=mst.first) return dp;
-        return mst;
+    return computeOptimalRouteFree(buildDistanceMatrix(g,locs));
+}
+pair<double,vector<int>> computeOptimalRouteFree(const DistanceMatrix& dist) {
+    // below ~13 stops the whole table is too small to be worth waking threads
+    int n=(int)dist.size();
+    if (n<=FLEXIBLE_EXACT_MAX) return n>=13 ? tspDPParallel(dist) : tspDP(dist);
+    // a kick budget and the fixed seed keep the route reproducible: 10n kicks
+    // match 100 ms of kicking up to ~100 stops at a fraction of the time. The
+    // clock only guards against very large inputs
+    LinKernighanOptions opts;
+    opts.maxKicks=10*n;
+    opts.timeLimitMs=1000;
+    return tspLinKernighan(dist,opts);
+}
+AnytimeTour tspAnytime(const DistanceMatrix& dist,chrono::steady_clock::time_point deadline) {
+    int n=(int)dist.size();
+    AnytimeTour best;
+    if (n<=3) {
+        // at most two orders to compare
+        auto exact=tspDP(dist);
+        best.length=exact.first; best.order=exact.second; best.stage="Held-Karp";
+        return best;
+    }
+    best.length=INF;
+    auto offer=[&](const vector<int>& tour,const char* stage) {
+        double len=tourLength(tour,dist);
+        if (best.order.empty() || len+1e-9<best.length) { best.length=len; best.order=tour; best.stage=stage; }
+    };
+    // greedy always runs so there is an answer even past the deadline
+    offer(greedyTSP(dist).second,"Greedy");
+    if (expired(&deadline)) return best;
+    vector<Edge> edges;
+    for (int i=0; i<n; ++i)
+        for (int j=i+1; j<n; ++j) edges.push_back({i,j,dist[i][j]});
+    vector<Edge> mst=kruskalMST(edges,n);
+    vector<int> tour=mstToTour(mst,n,0);
+    vector<vector<int>> nbrs=nearestNeighbors(dist,10);
+    localSearchStage(tour,dist,nbrs,TourMove::TwoOpt);
+    offer(tour,"MST + 2-opt");
+    if (expired(&deadline)) return best;
+    tour=best.order;
+    localSearch(tour,dist);
+    offer(tour,"Local Search");
+    if (expired(&deadline)) return best;
+    ThreadPool& pool=ThreadPool::shared();
+    bool parallel=n>=13 && pool.size()>1;
+    if (heldKarpTableBytes(n)<=HELD_KARP_MAX_BYTES) {
+        // exact, but all or nothing: a fill cut short by the deadline is dropped,
+        // so when even the estimate overruns the time left, skip allocating the
+        // table (up to ~110 MB) and spend that time on Lin-Kernighan instead
+        if (Clock::now()+heldKarpFillEstimate(n,parallel ? pool.size() : 1)<=deadline) {
+            HeldKarpTable hk(dist);
+            bool done=parallel ? fillLayers(hk,pool,&deadline) : fillSerial(hk,&deadline);
+            if (done) offer(hk.extract(dist).second,"Held-Karp");
+            return best;
+        }
     }
-    return tspMSTApproximation(g,locs);
+    LinKernighanOptions opts;
+    opts.timeLimitMs=(int)chrono::duration_cast<chrono::milliseconds>(deadline-Clock::now()).count();
+    offer(tspLinKernighan(dist,opts).second,"Lin-Kernighan");
+    return best;
 }
@@ -0,0 +1,192 @@
+#include "../include/algorithms.h"
+#include "../include/thread_pool.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+using namespace std;
+namespace {
+const double VRP_EPS=1e-9;
+struct Days {
+    const DistanceMatrix& d;
+    const vector<double>& service;
+    double limit;
+    vector<vector<int>> routes;   // each starts at stop 0
+    double time(const vector<int>& r) const {
+        double t=0;
+        for (size_t i=1; i<r.size(); ++i) t+=d[r[i-1]][r[i]]+service[r[i]];
+        return t;
+    }
+    // what a day costs the objective: its time, plus a steep charge for
+    // every minute over the limit so overfull days are emptied first; the
+    // squared term spreads overtime evenly when the limit cannot be met
+    double cost(double t) const {
+        double over=t-limit;
+        return over>0 ? t+1000*over+over*over : t;
+    }
+    double removeDelta(const vector<int>& r,int p) const {
+        int x=r[p];
+        double delta=-d[r[p-1]][x]-service[x];
+        if (p+1<(int)r.size()) delta+=d[r[p-1]][r[p+1]]-d[x][r[p+1]];
+        return delta;
+    }
+    // cheapest position to add x after, skipping position `skip` (the stop
+    // being swapped out); {after, extra time}
+    pair<int,double> insertDelta(const vector<int>& r,int x,int skip=-1) const {
+        int at=-1; double best=numeric_limits<double>::infinity();
+        for (int p=0; p<(int)r.size(); ++p) {
+            if (p==skip) continue;
+            int q=p+1==skip ? p+2 : p+1;
+            double c=d[r[p]][x]+service[x];
+            if (q<(int)r.size()) c+=d[x][r[q]]-d[r[p]][r[q]];
+            if (c<best) { best=c; at=p; }
+        }
+        return {at,best};
+    }
+};
+// Tour of one day over its stops, exact up to FLEXIBLE_EXACT_MAX stops like a
+// flexible route: k days solve at once, so 22-stop tables would add up fast.
+// Runs inside a parallelFor, so it must not use the pool itself.
+vector<int> solveDay(const DistanceMatrix& dist,const vector<int>& stops) {
+    int m=(int)stops.size();
+    if (m<=2) return stops;
+    DistanceMatrix sub(m,vector<double>(m));
+    for (int a=0; a<m; ++a)
+        for (int b=0; b<m; ++b) sub[a][b]=dist[stops[a]][stops[b]];
+    vector<int> order;
+    if (m<=FLEXIBLE_EXACT_MAX) {
+        order=tspDP(sub).second;
+    } else {
+        // a kick budget rather than a clock keeps the plan reproducible,
+        // so the clock is pushed out of reach
+        LinKernighanOptions opts;
+        opts.maxKicks=2*m;
+        opts.timeLimitMs=numeric_limits<int>::max();
+        order=tspLinKernighan(sub,opts).second;
+        // LK restarts from its own MST tour; never hand back a worse day
+        vector<int> given(m);
+        for (int a=0; a<m; ++a) given[a]=a;
+        if (tourLength(given,sub)<=tourLength(order,sub)) return stops;
+    }
+    vector<int> out(m);
+    for (int a=0; a<m; ++a) out[a]=stops[order[a]];
+    return out;
+}
+// k medoids seeded farthest-first from the start: a stop joins the day whose
+// medoid is nearest, medoids move to the member closest to the rest
+vector<vector<int>> cluster(const DistanceMatrix& dist,int k) {
+    int n=(int)dist.size();
+    vector<int> medoid;
+    vector<double> gap(n,numeric_limits<double>::infinity());
+    for (int v=1; v<n; ++v) gap[v]=dist[0][v];
+    while ((int)medoid.size()<k && (int)medoid.size()<n-1) {
+        int far=-1;
+        for (int v=1; v<n; ++v)
+            if (gap[v]>0 && (far==-1 || gap[v]>gap[far])) far=v;
+        if (far==-1) break;
+        medoid.push_back(far);
+        for (int v=1; v<n; ++v) gap[v]=min(gap[v],dist[far][v]);
+    }
+    vector<vector<int>> members(k);
+    for (int iter=0; iter<10; ++iter) {
+        for (auto& c:members) c.clear();
+        for (int v=1; v<n; ++v) {
+            int best=0;
+            for (int c=1; c<(int)medoid.size(); ++c)
+                if (dist[medoid[c]][v]<dist[medoid[best]][v]) best=c;
+            members[best].push_back(v);
+        }
+        bool moved=false;
+        for (int c=0; c<(int)medoid.size(); ++c) {
+            int best=medoid[c]; double bestSum=numeric_limits<double>::infinity();
+            for (int a:members[c]) {
+                double sum=0;
+                for (int b:members[c]) sum+=dist[a][b];
+                if (sum<bestSum-VRP_EPS) { bestSum=sum; best=a; }
+            }
+            if (best!=medoid[c]) { medoid[c]=best; moved=true; }
+        }
+        if (!moved) break;
+    }
+    return members;
+}
+}
+vector<DayRoute> planDays(const DistanceMatrix& dist,const vector<double>& service,int k,double dayLimit,ThreadPool& pool) {
+    int n=(int)dist.size();
+    k=min(k,max(n-1,1));   // a day per stop at most, the rest would stay empty
+    vector<DayRoute> out(max(k,0));
+    if (n==0 || k<=0) return out;
+    Days D{dist,service,dayLimit,vector<vector<int>>(k)};
+    vector<vector<int>> members=cluster(dist,k);
+    for (int c=0; c<k; ++c) {
+        D.routes[c].assign(1,0);
+        D.routes[c].insert(D.routes[c].end(),members[c].begin(),members[c].end());
+    }
+    vector<char> dirty(k,1);
+    auto resolve=[&]() {
+        vector<int> todo;
+        for (int c=0; c<k; ++c) if (dirty[c]) todo.push_back(c);
+        // days are independent: one exact/LK solve per changed day on the pool
+        pool.parallelFor((int)todo.size(),[&](int t) {
+            int c=todo[t];
+            D.routes[c]=solveDay(dist,D.routes[c]);
+        });
+        fill(dirty.begin(),dirty.end(),0);
+    };
+    resolve();
+    // Inter-route moves on the day tours: relocate one stop to another day, or
+    // swap two stops between days, each at its cheapest position. Accepted
+    // moves only dirty their two days, which are re-solved after the round.
+    for (int round=0; round<20; ++round) {
+        vector<double> t(k);
+        for (int c=0; c<k; ++c) t[c]=D.time(D.routes[c]);
+        bool improved=false;
+        for (int a=0; a<k; ++a) {
+            for (int p=1; p<(int)D.routes[a].size(); ++p) {
+                int x=D.routes[a][p];
+                double outA=D.removeDelta(D.routes[a],p);
+                for (int b=0; b<k; ++b) {
+                    if (b==a) continue;
+                    double before=D.cost(t[a])+D.cost(t[b]);
+                    auto ins=D.insertDelta(D.routes[b],x);
+                    if (D.cost(t[a]+outA)+D.cost(t[b]+ins.second)<before-VRP_EPS) {
+                        D.routes[a].erase(D.routes[a].begin()+p);
+                        D.routes[b].insert(D.routes[b].begin()+ins.first+1,x);
+                        t[a]+=outA; t[b]+=ins.second;
+                        dirty[a]=dirty[b]=1; improved=true;
+                        --p;
+                        break;
+                    }
+                    bool swapped=false;
+                    for (int q=1; q<(int)D.routes[b].size() && !swapped; ++q) {
+                        int y=D.routes[b][q];
+                        double outB=D.removeDelta(D.routes[b],q);
+                        // y takes a slot in a without x, x one in b without y
+                        auto intoA=D.insertDelta(D.routes[a],y,p);
+                        auto intoB=D.insertDelta(D.routes[b],x,q);
+                        double na=t[a]+outA+intoA.second,nb=t[b]+outB+intoB.second;
+                        if (D.cost(na)+D.cost(nb)>=before-VRP_EPS) continue;
+                        vector<int> ra=D.routes[a],rb=D.routes[b];
+                        ra.insert(ra.begin()+intoA.first+1,y);
+                        ra.erase(ra.begin()+(intoA.first<p ? p+1 : p));
+                        rb.insert(rb.begin()+intoB.first+1,x);
+                        rb.erase(rb.begin()+(intoB.first<q ? q+1 : q));
+                        D.routes[a].swap(ra); D.routes[b].swap(rb);
+                        t[a]=D.time(D.routes[a]); t[b]=D.time(D.routes[b]);
+                        dirty[a]=dirty[b]=1; improved=true; swapped=true;
+                    }
+                    if (swapped) break;
+                }
+            }
+        }
+        if (!improved) break;
+        resolve();
+    }
+    for (int c=0; c<k; ++c) {
+        out[c].order=D.routes[c];
+        out[c].time=D.time(D.routes[c]);
+    }
+    return out;
+}
+vector<DayRoute> planDays(const DistanceMatrix& dist,const vector<double>& service,int k,double dayLimit) {
+    return planDays(dist,service,k,dayLimit,ThreadPool::shared());
+}
@@ -0,0 +1,31 @@
+// Synthetic graph generator: writes <prefix>_attractions.csv,
+// <prefix>_roads.csv (the loadFromCSV schema) and <prefix>.snap (for
+// `optimizer --snapshot`). Shapes are described in graph_generator.h.
+//
+//   make tools && ./tools/bin/generate_graph <grid|geometric|road> <nodes> <seed> <prefix>
+
+#include "../include/graph.h"
+#include "../include/graph_generator.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+int main(int argc,char** argv) {
+    if (argc!=5 || atoi(argv[2])<=0) {
+        cerr<<"usage: "<<argv[0]<<" <grid|geometric|road> <nodes> <seed> <prefix>\n";
+        return 2;
+    }
+    Graph g;
+    if (!generateGraph(g,argv[1],atoi(argv[2]),(unsigned)strtoul(argv[3],nullptr,10))) {
+        cerr<<"unknown shape: "<<argv[1]<<"\n";
+        return 2;
+    }
+    string prefix=argv[4];
+    if (!g.saveCSV(prefix+"_attractions.csv",prefix+"_roads.csv") || !g.saveSnapshot(prefix+".snap")) return 1;
+    CSRView c=g.csr();
+    cout<<"wrote "<<prefix<<"_attractions.csv, "<<prefix<<"_roads.csv, "<<prefix<<".snap: "
+        <<g.size()<<" attractions, "<<c.offsets[c.numNodes]/2<<" roads"
+        <<(g.isFullyConnected() ? "" : " (not connected)")<<"\n";
+    return 0;
+}
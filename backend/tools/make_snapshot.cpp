@@ -0,0 +1,37 @@
+// Offline converter: parse a graph once and write the binary snapshot that
+// `optimizer --snapshot FILE` maps at startup. Besides our CSVs it takes
+// DIMACS road networks and plain edge lists, for benchmarking at scale.
+//
+//   make tools
+//   ./tools/bin/make_snapshot attractions.csv roads.csv graph.snap
+//   ./tools/bin/make_snapshot --dimacs USA-road-t.NY.gr [USA-road-d.NY.co] ny.snap
+//   ./tools/bin/make_snapshot --edges graph.txt graph.snap
+
+#include "../include/graph.h"
+#include <iostream>
+#include <string>
+using namespace std;
+
+int main(int argc,char** argv) {
+    string mode=argc>1 ? argv[1] : "";
+    Graph g;
+    bool ok;
+    if (mode=="--dimacs" && (argc==4 || argc==5)) ok=g.loadFromDIMACS(argv[2],argc==5 ? argv[3] : "");
+    else if (mode=="--edges" && argc==4) ok=g.loadFromEdgeList(argv[2]);
+    else if (argc==4 && mode.rfind("--",0)!=0) {
+        g.loadFromCSV(argv[1],argv[2]);
+        ok=!g.getAllAttractionIds().empty();
+        if (!ok) cerr<<"no attractions loaded from "<<argv[1]<<"\n";
+    } else {
+        cerr<<"usage: "<<argv[0]<<" attractions.csv roads.csv out.snap\n"
+            <<"       "<<argv[0]<<" --dimacs graph.gr [graph.co] out.snap\n"
+            <<"       "<<argv[0]<<" --edges edges.txt out.snap\n";
+        return 2;
+    }
+    const char* out=argv[argc-1];
+    if (!ok || !g.saveSnapshot(out)) return 1;
+    CSRView c=g.csr();
+    cout<<"wrote "<<out<<": "<<g.getAllAttractionIds().size()<<" attractions, "
+        <<(c.numNodes>0 ? c.offsets[c.numNodes]/2 : 0)<<" roads\n";
+    return 0;
+}